@@ -0,0 +1,51 @@
+// AIM
+// the view is yaw and pitch accumulated from mouse counts, not mapped
+// from the cursor position, so it never wraps at the window edge and
+// one count always turns by the same angle
+// doubles so hours of tiny deltas don't drift
+
+// just short of straight up/down so the view never flips
+#define PITCH_LIMIT (M_PI / 2 - 1e-4)
+
+// radians, yaw 0 and pitch 0 look down -z
+typedef struct {
+  double yaw;
+  double pitch;
+} aim_t;
+
+// counts360 wins over cm360 when both are set
+double aim_rad_per_count(void) {
+  double counts = global_settings.counts360;
+  if (counts <= 0) {
+    counts = global_settings.cm360 / 2.54 * global_settings.dpi;
+  }
+  assert(counts > 0 && "SENSITIVITY MUST BE SET WITH cm360 AND dpi OR counts360");
+  return 2 * M_PI / counts;
+}
+
+// mouse right turns right, mouse down looks down
+aim_t aim_turn(aim_t a, Vector2 delta) {
+  double k = aim_rad_per_count();
+  a.yaw = remainder(a.yaw - delta.x * k, 2 * M_PI);
+  a.pitch = a.pitch - delta.y * k;
+  if (a.pitch > PITCH_LIMIT) a.pitch = PITCH_LIMIT;
+  if (a.pitch < -PITCH_LIMIT) a.pitch = -PITCH_LIMIT;
+  return a;
+}
+
+// the short way round, yaw wraps at +-PI
+aim_t aim_lerp(aim_t a, aim_t b, float u) {
+  return (aim_t) {
+    .yaw = a.yaw + remainder(b.yaw - a.yaw, 2 * M_PI) * u,
+    .pitch = a.pitch + (b.pitch - a.pitch) * u,
+  };
+}
+
+Vector3 aim_dir(aim_t a) {
+  double cp = cos(a.pitch);
+  return (Vector3) {
+    -sin(a.yaw) * cp,
+    sin(a.pitch),
+    -cos(a.yaw) * cp,
+  };
+}
@@ -0,0 +1,174 @@
+// ASSETS
+// loading that doesn't block the window
+// each asset is read and decoded into plain memory by a task on the
+// worker pool (see workers_submit), the main thread only puts the
+// results on the gpu and spends at most ASSET_FRAME_BUDGET a frame
+// doing it so a loading screen keeps drawing in between
+// textures go up ASSET_UPLOAD_ROWS rows at a time, the rest in one go
+
+#define ASSET_CAP 16
+// seconds
+#define ASSET_FRAME_BUDGET 0.004
+#define ASSET_UPLOAD_ROWS 64
+
+typedef enum {
+  // image file to a texture
+  AK_TEXTURE,
+  // ttf through the font cache (see load_font_data_cached)
+  AK_FONT,
+  // rasterizes into its texture as it goes so it all happens on the
+  // main thread (see dynfont.c)
+  AK_DYN_FONT,
+  // scenario file parsed on its own, merged into the scenarios and rigs
+  // on the main thread, then the rigs it added
+  // NOTE: raylib's LoadModel uploads the meshes as it reads them so
+  // each rig is loaded whole on the main thread
+  AK_SCENARIO,
+  AK_CNT
+} asset_kind_e;
+
+typedef struct {
+  asset_kind_e kind;
+  const char *path;
+  // AK_FONT and AK_DYN_FONT
+  int size;
+  int type;
+  // results, AK_TEXTURE also hands over the image if image isn't NULL
+  Texture2D *texture;
+  Image *image;
+  Font *font;
+
+  worker_task_t task;
+  // from the task
+  Image pixels;
+  font_data_t font_data;
+  scenario_file_t scenario;
+  // upload progress
+  Texture2D uploaded;
+  int rows;
+  bool merged;
+  // rigs the scenario added, [rig, rig_end)
+  size_t rig;
+  size_t rig_end;
+  bool done;
+} asset_t;
+
+struct {
+  asset_t data[ASSET_CAP];
+  size_t len;
+  size_t done;
+} assets;
+
+// runs on a worker
+void asset_decode(void *ctx) {
+  asset_t *a = ctx;
+  switch (a->kind) {
+  case AK_TEXTURE:  { a->pixels = LoadImage(a->path); break; }
+  case AK_FONT:     { a->font_data = load_font_data_cached(a->path, a->size, NULL, 0, a->type); break; }
+  case AK_DYN_FONT: { break; }
+  case AK_SCENARIO: { load_scenario(a->path, &a->scenario); break; }
+  default: assert(false && "UNREACHABLE");
+  }
+}
+
+// returns true once all of image is in a->uploaded
+bool asset_upload_rows(asset_t *a, Image image, double deadline) {
+  if (a->uploaded.id == 0) {
+    a->uploaded = (Texture2D) {
+      .id = rlLoadTexture(NULL, image.width, image.height, image.format, 1),
+      .width = image.width,
+      .height = image.height,
+      .mipmaps = 1,
+      .format = image.format,
+    };
+    assert(a->uploaded.id != 0 && "COULD NOT CREATE TEXTURE");
+  }
+  int stride = GetPixelDataSize(image.width, 1, image.format);
+  while (a->rows < image.height && GetTime() < deadline) {
+    int n = image.height - a->rows;
+    if (n > ASSET_UPLOAD_ROWS) n = ASSET_UPLOAD_ROWS;
+    rlUpdateTexture(a->uploaded.id, 0, a->rows, image.width, n, image.format,
+		    (unsigned char *)image.data + a->rows * stride);
+    a->rows += n;
+  }
+  return a->rows == image.height;
+}
+
+// returns true once the asset is ready to use
+bool asset_upload(asset_t *a, double deadline) {
+  switch (a->kind) {
+  case AK_TEXTURE: {
+    if (!IsImageReady(a->pixels)) {
+      printf("Could not load %s\n", a->path);
+      *a->texture = (Texture2D) {};
+      return true;
+    }
+    if (!asset_upload_rows(a, a->pixels, deadline)) return false;
+    *a->texture = a->uploaded;
+    if (a->image) *a->image = a->pixels;
+    else UnloadImage(a->pixels);
+    return true;
+  }
+  case AK_FONT: {
+    // the theme falls back on the default font
+    if (!a->font_data.font.glyphs) {
+      *a->font = GetFontDefault();
+      return true;
+    }
+    if (!asset_upload_rows(a, a->font_data.atlas, deadline)) return false;
+    *a->font = load_font_texture(&a->font_data, a->uploaded);
+    return true;
+  }
+  case AK_DYN_FONT: {
+    *a->font = load_dyn_font(a->path, a->size, a->type);
+    return true;
+  }
+  case AK_SCENARIO: {
+    if (!a->merged) {
+      a->rig = rigs.len;
+      merge_scenario_file(&a->scenario);
+      a->rig_end = rigs.len;
+      a->merged = true;
+    }
+    // one rig per call
+    if (a->rig < a->rig_end) load_rig(&rigs.data[a->rig++]);
+    return a->rig == a->rig_end;
+  }
+  default: assert(false && "UNREACHABLE");
+  }
+  return true;
+}
+
+// queues a, which is decoded in the background from now on
+void asset_load(asset_t a) {
+  assert(assets.len < ASSET_CAP && "TOO MANY ASSETS LOADING");
+  asset_t *q = &assets.data[assets.len++];
+  *q = a;
+  q->task = (worker_task_t) { .fn = asset_decode, .ctx = q };
+  workers_submit(&q->task);
+}
+
+// call once a frame, uploads whatever has been decoded for up to budget
+// seconds and returns true once everything queued is ready
+bool assets_update(double budget) {
+  // nobody else will decode them, one per frame keeps the screen going
+  if (workers.cnt == 0) workers_run_task();
+
+  double deadline = GetTime() + budget;
+  for (size_t i = 0; i < assets.len && GetTime() < deadline; ++i) {
+    asset_t *a = &assets.data[i];
+    if (a->done || !workers_task_done(&a->task)) continue;
+    a->done = asset_upload(a, deadline);
+    if (a->done) assets.done++;
+  }
+  if (assets.done < assets.len) return false;
+  assets.len = 0;
+  assets.done = 0;
+  return true;
+}
+
+// 0 to 1, for a loading bar
+float assets_progress(void) {
+  if (assets.len == 0) return 1;
+  return (float)assets.done / assets.len;
+}
@@ -0,0 +1,326 @@
+// DYNAMIC FONTS
+// fonts that rasterize a glyph the first time some text uses it, so
+// player names and scenario titles can hold any codepoint without the
+// whole font being rasterized up front
+// glyphs live in one fixed size atlas, packed left to right on shelves
+// and uploaded one rect at a time. when it is full the least recently
+// used glyphs are evicted one by one until the new glyph fits in their
+// rects, glyphs drawn this frame are never evicted so text already
+// batched keeps sampling the right texels
+// the raylib font inside is drawn like any other (see text_run in
+// ui.c), but its glyph indices change as glyphs come and go so it must
+// be looked up again with find_dyn_font rather than copied
+
+#define DYN_FONT_CAP 2
+#define DYN_FONT_GLYPH_CAP 1024
+#define DYN_FONT_ATLAS_SIZE 1024
+// blank texels around each glyph so filtering doesn't bleed
+#define DYN_FONT_PAD 1
+// shelf heights are rounded up to this so glyphs of close heights share
+#define DYN_FONT_SHELF_STEP 4
+// every glyph frees at most one span, every shelf starts with one
+#define DYN_FONT_SPAN_CAP (DYN_FONT_GLYPH_CAP + DYN_FONT_ATLAS_SIZE)
+
+typedef struct {
+  int y;
+  int h;
+} shelf_t;
+
+// free run of a shelf
+typedef struct {
+  int shelf;
+  int x;
+  int w;
+} shelf_span_t;
+
+typedef struct {
+  // glyphs and recs hold DYN_FONT_GLYPH_CAP, glyphCount are in use
+  // NOTE: the '?' glyph stays first, raylib falls back on it
+  Font font;
+  int type;
+  unsigned char *ttf;
+  int ttf_len;
+  // top to bottom, only the last one is given back when it empties
+  shelf_t *shelves;
+  size_t shelf_len;
+  // sorted by shelf then x
+  shelf_span_t *spans;
+  size_t span_len;
+  // tick of the last text each glyph was in
+  size_t used[DYN_FONT_GLYPH_CAP];
+  size_t tick;
+  // first tick of the frame, glyphs used since are on screen
+  size_t frame_tick;
+  // bumped when glyphs come or go, anything laid out before may have
+  // a stale rect or a '?' where a glyph now is
+  size_t generation;
+} dyn_font_t;
+
+struct {
+  dyn_font_t data[DYN_FONT_CAP];
+  size_t len;
+} dyn_fonts;
+
+dyn_font_t *find_dyn_font(unsigned int texture) {
+  for (size_t i = 0; i < dyn_fonts.len; ++i) {
+    if (dyn_fonts.data[i].font.texture.id == texture) return &dyn_fonts.data[i];
+  }
+  return NULL;
+}
+
+// call once a frame before any text is drawn
+void dyn_fonts_frame(void) {
+  for (size_t i = 0; i < dyn_fonts.len; ++i) {
+    dyn_fonts.data[i].frame_tick = dyn_fonts.data[i].tick + 1;
+  }
+}
+
+void span_insert(dyn_font_t *f, size_t k, shelf_span_t span) {
+  assert(f->span_len < DYN_FONT_SPAN_CAP && "TOO MANY FREE SPANS");
+  memmove(&f->spans[k + 1], &f->spans[k], (f->span_len - k) * sizeof(*f->spans));
+  f->spans[k] = span;
+  f->span_len++;
+}
+
+void span_remove(dyn_font_t *f, size_t k) {
+  memmove(&f->spans[k], &f->spans[k + 1], (f->span_len - k - 1) * sizeof(*f->spans));
+  f->span_len--;
+}
+
+// the shortest shelf that takes it, a new one if those are much taller
+// and there's room, returns false if the rect doesn't fit anywhere
+bool shelf_alloc(dyn_font_t *f, int w, int h, int *x, int *y) {
+  int width = f->font.texture.width, height = f->font.texture.height;
+  size_t best = f->span_len;
+  for (size_t k = 0; k < f->span_len; ++k) {
+    const shelf_span_t *s = &f->spans[k];
+    int sh = f->shelves[s->shelf].h;
+    if (s->w < w || sh < h) continue;
+    // then the narrowest span so less is wasted
+    if (best == f->span_len || sh < f->shelves[f->spans[best].shelf].h ||
+	(sh == f->shelves[f->spans[best].shelf].h && s->w < f->spans[best].w)) best = k;
+  }
+  int step = (h + DYN_FONT_SHELF_STEP - 1) / DYN_FONT_SHELF_STEP * DYN_FONT_SHELF_STEP;
+  if (step > height) step = height;
+  int top = (f->shelf_len > 0) ? f->shelves[f->shelf_len - 1].y + f->shelves[f->shelf_len - 1].h : 0;
+  bool tight = (best < f->span_len && 2 * f->shelves[f->spans[best].shelf].h <= 3 * step);
+  if (!tight && w <= width && top + step <= height) {
+    f->shelves[f->shelf_len++] = (shelf_t) { top, step };
+    best = f->span_len;
+    span_insert(f, best, (shelf_span_t) { f->shelf_len - 1, 0, width });
+  }
+  if (best == f->span_len) return false;
+
+  shelf_span_t *s = &f->spans[best];
+  *x = s->x;
+  *y = f->shelves[s->shelf].y;
+  s->x += w;
+  s->w -= w;
+  if (s->w == 0) span_remove(f, best);
+  return true;
+}
+
+// gives a rect from shelf_alloc back, merged with the free spans next
+// to it
+void shelf_free(dyn_font_t *f, int x, int y, int w) {
+  int shelf = 0;
+  while (f->shelves[shelf].y != y) ++shelf;
+  size_t k = 0;
+  while (k < f->span_len && (f->spans[k].shelf < shelf || (f->spans[k].shelf == shelf && f->spans[k].x < x))) ++k;
+  span_insert(f, k, (shelf_span_t) { shelf, x, w });
+  if (k + 1 < f->span_len && f->spans[k + 1].shelf == shelf && f->spans[k + 1].x == x + w) {
+    f->spans[k].w += f->spans[k + 1].w;
+    span_remove(f, k + 1);
+  }
+  if (k > 0 && f->spans[k - 1].shelf == shelf && f->spans[k - 1].x + f->spans[k - 1].w == x) {
+    f->spans[k - 1].w += f->spans[k].w;
+    span_remove(f, k);
+  }
+  // empty shelves at the bottom can be opened again at another height
+  while (f->span_len > 0) {
+    const shelf_span_t *last = &f->spans[f->span_len - 1];
+    if (last->shelf != (int)f->shelf_len - 1 || last->w != f->font.texture.width) break;
+    f->span_len--;
+    f->shelf_len--;
+  }
+}
+
+// the rect of glyph i with its padding into pixels (the atlas format,
+// stride in pixels), coverage goes in alpha like raylib's atlases
+void dyn_font_blit(const dyn_font_t *f, int i, unsigned char *pixels, int stride) {
+  const Image *g = &f->font.glyphs[i].image;
+  const unsigned char *src = g->data;
+  int pad = f->font.glyphPadding;
+  for (int y = 0; y < g->height + 2 * pad; ++y) {
+    unsigned char *row = &pixels[2 * y * stride];
+    for (int x = 0; x < g->width + 2 * pad; ++x) {
+      bool inside = src && x >= pad && x < g->width + pad && y >= pad && y < g->height + pad;
+      row[2 * x] = 255;
+      row[2 * x + 1] = inside ? src[(y - pad) * g->width + x - pad] : 0;
+    }
+  }
+}
+
+// only the glyph's rect is sent
+void dyn_font_upload(const dyn_font_t *f, int i) {
+  const Image *g = &f->font.glyphs[i].image;
+  int pad = f->font.glyphPadding;
+  int w = g->width + 2 * pad, h = g->height + 2 * pad;
+  unsigned char *pixels = malloc(2 * w * h);
+  assert(pixels && "MALLOC FAILED");
+  dyn_font_blit(f, i, pixels, w);
+  rlUpdateTexture(f->font.texture.id, f->font.recs[i].x - pad, f->font.recs[i].y - pad, w, h,
+		  f->font.texture.format, pixels);
+  free(pixels);
+}
+
+bool dyn_font_place(dyn_font_t *f, const Image *g, Rectangle *rec) {
+  int pad = f->font.glyphPadding;
+  int x, y;
+  if (!shelf_alloc(f, g->width + 2 * pad, g->height + 2 * pad, &x, &y)) return false;
+  *rec = (Rectangle) { x + pad, y + pad, g->width, g->height };
+  return true;
+}
+
+// its texels are left as they are, nothing samples a free rect
+void dyn_font_remove(dyn_font_t *f, int i) {
+  int pad = f->font.glyphPadding;
+  Rectangle rec = f->font.recs[i];
+  shelf_free(f, rec.x - pad, rec.y - pad, rec.width + 2 * pad);
+  UnloadImage(f->font.glyphs[i].image);
+  int n = --f->font.glyphCount;
+  f->font.glyphs[i] = f->font.glyphs[n];
+  f->font.recs[i] = f->font.recs[n];
+  f->used[i] = f->used[n];
+  f->generation++;
+}
+
+// drops the least recently used glyph that isn't on screen this frame
+// returns false if there was nothing to drop
+bool dyn_font_evict(dyn_font_t *f) {
+  int oldest = -1;
+  for (int i = 1; i < f->font.glyphCount; ++i) {
+    if (f->used[i] < f->frame_tick && (oldest < 0 || f->used[i] < f->used[oldest])) oldest = i;
+  }
+  if (oldest < 0) return false;
+  dyn_font_remove(f, oldest);
+  return true;
+}
+
+// takes the glyph's image, drops the glyph if it can't fit without
+// evicting glyphs on screen, the text shows '?' until a later frame
+void dyn_font_add(dyn_font_t *f, GlyphInfo glyph) {
+  // never drawn, LoadFontData gives it a blank image as big as a glyph
+  if (glyph.value == ' ') {
+    UnloadImage(glyph.image);
+    glyph.image = (Image) { .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+  }
+  while (f->font.glyphCount == DYN_FONT_GLYPH_CAP) {
+    if (!dyn_font_evict(f)) {
+      UnloadImage(glyph.image);
+      return;
+    }
+  }
+  Rectangle rec;
+  while (!dyn_font_place(f, &glyph.image, &rec)) {
+    if (!dyn_font_evict(f)) {
+      UnloadImage(glyph.image);
+      return;
+    }
+  }
+  int i = f->font.glyphCount++;
+  f->font.glyphs[i] = glyph;
+  f->font.recs[i] = rec;
+  f->used[i] = f->tick;
+  dyn_font_upload(f, i);
+  f->generation++;
+}
+
+// rasterizes whatever in text isn't in the atlas yet and marks the
+// glyphs text uses as used, call before laying text out
+void dyn_font_prepare(dyn_font_t *f, const char *text) {
+  f->tick++;
+  int *missing = NULL;
+  int missing_cnt = 0;
+  for (int i = 0; text[i];) {
+    int bytes = 0;
+    int codepoint = GetCodepointNext(&text[i], &bytes);
+    i += bytes;
+    int index = GetGlyphIndex(f->font, codepoint);
+    if (f->font.glyphs[index].value == codepoint) {
+      f->used[index] = f->tick;
+      continue;
+    }
+    bool seen = false;
+    for (int k = 0; k < missing_cnt; ++k) seen |= (missing[k] == codepoint);
+    if (seen) continue;
+    // at most one per byte
+    if (!missing) missing = malloc(strlen(text) * sizeof(*missing));
+    assert(missing && "MALLOC FAILED");
+    missing[missing_cnt++] = codepoint;
+  }
+  if (missing_cnt == 0) return;
+
+  // all at once so raylib spreads them over the workers
+  GlyphInfo *glyphs = LoadFontData(f->ttf, f->ttf_len, f->font.baseSize, missing, missing_cnt, f->type);
+  free(missing);
+  if (!glyphs) return;
+  for (int i = 0; i < missing_cnt; ++i) dyn_font_add(f, glyphs[i]);
+  RL_FREE(glyphs);
+
+  RL_FREE(f->font.glyphLookup);
+  f->font.glyphLookup = LoadFontGlyphLookup(f->font.glyphs, f->font.glyphCount);
+}
+
+void unload_dyn_font(dyn_font_t *f) {
+  UnloadFont(f->font);
+  UnloadFileData(f->ttf);
+  free(f->shelves);
+  free(f->spans);
+  *f = (dyn_font_t) {};
+}
+
+// type is FONT_DEFAULT or FONT_SDF, starts with printable ascii
+// NOTE: sdf fonts are drawn with the sdf text shader (see ui.c)
+Font load_dyn_font(const char *path, int size, int type) {
+  assert(dyn_fonts.len < DYN_FONT_CAP && "TOO MANY DYNAMIC FONTS");
+  dyn_font_t *f = &dyn_fonts.data[dyn_fonts.len];
+  *f = (dyn_font_t) { .type = type };
+  f->ttf = LoadFileData(path, &f->ttf_len);
+  if (!f->ttf) return GetFontDefault();
+
+  Image atlas = GenImageColor(DYN_FONT_ATLAS_SIZE, DYN_FONT_ATLAS_SIZE, BLANK);
+  ImageFormat(&atlas, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA);
+  f->font = (Font) {
+    .baseSize = size,
+    .glyphPadding = DYN_FONT_PAD,
+    .texture = LoadTextureFromImage(atlas),
+    .glyphs = RL_CALLOC(DYN_FONT_GLYPH_CAP, sizeof(*f->font.glyphs)),
+    .recs = RL_CALLOC(DYN_FONT_GLYPH_CAP, sizeof(*f->font.recs)),
+  };
+  UnloadImage(atlas);
+  f->shelves = malloc(DYN_FONT_ATLAS_SIZE * sizeof(*f->shelves));
+  f->spans = malloc(DYN_FONT_SPAN_CAP * sizeof(*f->spans));
+  assert(f->font.glyphs && f->font.recs && f->shelves && f->spans && "MALLOC FAILED");
+  dyn_fonts.len++;
+  // distances are interpolated between texels
+  if (type == FONT_SDF) SetTextureFilter(f->font.texture, TEXTURE_FILTER_BILINEAR);
+
+  char ascii[96] = "?";
+  for (int c = ' '; c <= '~'; ++c) {
+    if (c != '?') ascii[strlen(ascii)] = c;
+  }
+  dyn_font_prepare(f, ascii);
+  if (f->font.glyphCount == 0) {
+    printf("Could not rasterize %s\n", path);
+    unload_dyn_font(f);
+    dyn_fonts.len--;
+    return GetFontDefault();
+  }
+  return f->font;
+}
+
+void unload_dyn_fonts(void) {
+  for (size_t i = 0; i < dyn_fonts.len; ++i) unload_dyn_font(&dyn_fonts.data[i]);
+  dyn_fonts.len = 0;
+}
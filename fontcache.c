@@ -0,0 +1,247 @@
+#include <stdint.h>
+#include <sys/stat.h>
+
+// FONT CACHE
+// rasterized font atlases saved to disk so a ttf is only rasterized the
+// first time it is loaded with a given file, size, codepoint set and
+// glyph type (FONT_DEFAULT or FONT_SDF)
+// a cache file is named after the hash of all four and holds a header,
+// the glyph metrics and the atlas pixels
+// everything but the texture upload is plain memory and files, so
+// load_font_data_cached can run on a worker (see assets.c)
+
+#define FONT_CACHE_DIR "font_cache"
+#define FONT_CACHE_MAGIC 0x43544e46
+// bump when the file layout or the way raylib builds atlases changes
+#define FONT_CACHE_VERSION 3
+// around bitmap glyphs in the atlas, as LoadFontFromMemory
+#define FONT_BITMAP_PAD 4
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t key;
+  int32_t base_size;
+  int32_t glyph_cnt;
+  int32_t glyph_padding;
+  // atlas
+  int32_t width;
+  int32_t height;
+  int32_t format;
+} font_cache_header_t;
+
+typedef struct {
+  int32_t value;
+  int32_t offset_x;
+  int32_t offset_y;
+  int32_t advance_x;
+  Rectangle rec;
+} font_cache_glyph_t;
+
+// a font without its texture, the atlas is uploaded with load_font_texture
+// NOTE: font.glyphs is NULL if it couldn't be loaded
+typedef struct {
+  Font font;
+  Image atlas;
+  int type;
+} font_data_t;
+
+uint64_t fnv1a(uint64_t h, const void *data, size_t len) {
+  const unsigned char *c = data;
+  for (size_t i = 0; i < len; ++i) h = (h ^ c[i]) * 1099511628211ull;
+  return h;
+}
+
+uint64_t font_cache_key(const unsigned char *data, int len, int size, int *codepoints, int codepoint_cnt, int type) {
+  int params[] = { FONT_CACHE_VERSION, size, codepoint_cnt, type };
+  uint64_t h = fnv1a(14695981039346656037ull, data, len);
+  h = fnv1a(h, params, sizeof(params));
+  if (codepoints) h = fnv1a(h, codepoints, codepoint_cnt * sizeof(*codepoints));
+  return h;
+}
+
+// every glyph rect inside the atlas, written the other way round so a
+// NaN fails too
+bool font_cache_recs_fit(const font_cache_glyph_t *glyphs, int cnt, int width, int height) {
+  for (int i = 0; i < cnt; ++i) {
+    Rectangle r = glyphs[i].rec;
+    if (!(r.x >= 0 && r.y >= 0 && r.width >= 0 && r.height >= 0 &&
+	  r.x + r.width <= width && r.y + r.height <= height)) return false;
+  }
+  return true;
+}
+
+// returns no glyphs if the file is missing, doesn't match the key or
+// has a glyph outside the atlas
+font_data_t font_cache_load(const char *path, uint64_t key) {
+  font_data_t d = {};
+  if (!FileExists(path)) return d;
+  int len = 0;
+  unsigned char *data = LoadFileData(path, &len);
+  font_cache_header_t h = {};
+  if (data && len >= (int)sizeof(h)) memcpy(&h, data, sizeof(h));
+  size_t glyphs_len = (h.glyph_cnt > 0) ? h.glyph_cnt * sizeof(font_cache_glyph_t) : 0;
+  size_t pixels_len = (h.width > 0 && h.height > 0) ? GetPixelDataSize(h.width, h.height, h.format) : 0;
+  if (h.magic != FONT_CACHE_MAGIC || h.version != FONT_CACHE_VERSION || h.key != key ||
+      glyphs_len == 0 || pixels_len == 0 || (size_t)len != sizeof(h) + glyphs_len + pixels_len ||
+      !font_cache_recs_fit((const font_cache_glyph_t *)(data + sizeof(h)), h.glyph_cnt, h.width, h.height)) {
+    printf("Font cache %s is stale, rebuilding it\n", path);
+    UnloadFileData(data);
+    return d;
+  }
+
+  const font_cache_glyph_t *glyphs = (const font_cache_glyph_t *)(data + sizeof(h));
+  d.atlas = (Image) {
+    .data = RL_MALLOC(pixels_len),
+    .width = h.width,
+    .height = h.height,
+    .mipmaps = 1,
+    .format = h.format,
+  };
+  // freed by UnloadFont so allocated like raylib does
+  Font *font = &d.font;
+  font->baseSize = h.base_size;
+  font->glyphCount = h.glyph_cnt;
+  font->glyphPadding = h.glyph_padding;
+  font->glyphs = RL_MALLOC(h.glyph_cnt * sizeof(*font->glyphs));
+  font->recs = RL_MALLOC(h.glyph_cnt * sizeof(*font->recs));
+  assert(d.atlas.data && font->glyphs && font->recs && "MALLOC FAILED");
+  memcpy(d.atlas.data, data + sizeof(h) + glyphs_len, pixels_len);
+  for (int i = 0; i < h.glyph_cnt; ++i) {
+    font->glyphs[i] = (GlyphInfo) {
+      .value = glyphs[i].value,
+      .offsetX = glyphs[i].offset_x,
+      .offsetY = glyphs[i].offset_y,
+      .advanceX = glyphs[i].advance_x,
+      // same as LoadFontFromMemory, ImageDrawText draws from these
+      .image = ImageFromImage(d.atlas, glyphs[i].rec),
+    };
+    font->recs[i] = glyphs[i].rec;
+  }
+  font->glyphLookup = LoadFontGlyphLookup(font->glyphs, font->glyphCount);
+  UnloadFileData(data);
+  return d;
+}
+
+void font_cache_save(const char *path, uint64_t key, Font font, Image atlas) {
+  font_cache_header_t h = {
+    .magic = FONT_CACHE_MAGIC,
+    .version = FONT_CACHE_VERSION,
+    .key = key,
+    .base_size = font.baseSize,
+    .glyph_cnt = font.glyphCount,
+    .glyph_padding = font.glyphPadding,
+    .width = atlas.width,
+    .height = atlas.height,
+    .format = atlas.format,
+  };
+  size_t glyphs_len = font.glyphCount * sizeof(font_cache_glyph_t);
+  size_t pixels_len = GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+  size_t len = sizeof(h) + glyphs_len + pixels_len;
+  unsigned char *data = malloc(len);
+  assert(data && "MALLOC FAILED");
+  memcpy(data, &h, sizeof(h));
+  font_cache_glyph_t *glyphs = (font_cache_glyph_t *)(data + sizeof(h));
+  for (int i = 0; i < font.glyphCount; ++i) {
+    glyphs[i] = (font_cache_glyph_t) {
+      .value = font.glyphs[i].value,
+      .offset_x = font.glyphs[i].offsetX,
+      .offset_y = font.glyphs[i].offsetY,
+      .advance_x = font.glyphs[i].advanceX,
+      .rec = font.recs[i],
+    };
+  }
+  memcpy(data + sizeof(h) + glyphs_len, atlas.data, pixels_len);
+
+  if (!DirectoryExists(FONT_CACHE_DIR)) mkdir(FONT_CACHE_DIR, 0755);
+  if (!SaveFileData(path, data, len)) printf("Could not write font cache %s\n", path);
+  free(data);
+}
+
+// glyph images are cut from the atlas like LoadFontFromMemory does,
+// ImageDrawText draws from them
+void font_data_finish(font_data_t *d) {
+  for (int i = 0; i < d->font.glyphCount; ++i) {
+    UnloadImage(d->font.glyphs[i].image);
+    d->font.glyphs[i].image = ImageFromImage(d->atlas, d->font.recs[i]);
+  }
+  d->font.glyphLookup = LoadFontGlyphLookup(d->font.glyphs, d->font.glyphCount);
+}
+
+// LoadFontFromMemory without the texture
+font_data_t load_font_bitmap(const unsigned char *data, int len, int size, int *codepoints, int codepoint_cnt) {
+  font_data_t d = {
+    .font = {
+      .baseSize = size,
+      .glyphCount = (codepoint_cnt > 0) ? codepoint_cnt : 95,
+      .glyphPadding = FONT_BITMAP_PAD,
+    },
+    .type = FONT_DEFAULT,
+  };
+  d.font.glyphs = LoadFontData(data, len, size, codepoints, d.font.glyphCount, FONT_DEFAULT);
+  if (!d.font.glyphs) return d;
+  d.atlas = GenImageFontAtlas(d.font.glyphs, &d.font.recs, d.font.glyphCount, size, FONT_BITMAP_PAD, 2);
+  font_data_finish(&d);
+  return d;
+}
+
+// signed distance field glyphs, like raylib's text_font_sdf example the
+// atlas has no padding as the glyphs carry their own
+// NOTE: the atlas is packed to a tight npot size, fine on gl 3.3
+font_data_t load_font_sdf(const unsigned char *data, int len, int size, int *codepoints, int codepoint_cnt) {
+  font_data_t d = {
+    .font = {
+      .baseSize = size,
+      .glyphCount = (codepoint_cnt > 0) ? codepoint_cnt : 95,
+    },
+    .type = FONT_SDF,
+  };
+  d.font.glyphs = LoadFontData(data, len, size, codepoints, d.font.glyphCount, FONT_SDF);
+  if (!d.font.glyphs) return d;
+  d.atlas = GenImageFontAtlas(d.font.glyphs, &d.font.recs, d.font.glyphCount, size, 0, 3);
+  font_data_finish(&d);
+  return d;
+}
+
+// the font through the cache, type is FONT_DEFAULT or FONT_SDF
+// NOTE: no gl calls, safe on any thread
+font_data_t load_font_data_cached(const char *path, int size, int *codepoints, int codepoint_cnt, int type) {
+  font_data_t d = { .type = type };
+  int len = 0;
+  unsigned char *data = LoadFileData(path, &len);
+  if (!data) return d;
+
+  uint64_t key = font_cache_key(data, len, size, codepoints, codepoint_cnt, type);
+  char cache_path[64];
+  snprintf(cache_path, sizeof(cache_path), FONT_CACHE_DIR "/%016llx.font", (unsigned long long)key);
+  d = font_cache_load(cache_path, key);
+  if (!d.font.glyphs) {
+    d = (type == FONT_SDF)
+      ? load_font_sdf(data, len, size, codepoints, codepoint_cnt)
+      : load_font_bitmap(data, len, size, codepoints, codepoint_cnt);
+    if (d.font.glyphs) font_cache_save(cache_path, key, d.font, d.atlas);
+  }
+  d.type = type;
+  UnloadFileData(data);
+  return d;
+}
+
+// gives the font its uploaded atlas and frees the cpu one
+Font load_font_texture(font_data_t *d, Texture2D texture) {
+  Font font = d->font;
+  font.texture = texture;
+  // distances are interpolated between texels
+  if (d->type == FONT_SDF) SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+  UnloadImage(d->atlas);
+  *d = (font_data_t) {};
+  return font;
+}
+
+// LoadFontEx through the cache, type is FONT_DEFAULT or FONT_SDF, falls
+// back on the default font
+// NOTE: sdf fonts are drawn with the sdf text shader (see ui.c)
+Font load_font_cached(const char *path, int size, int *codepoints, int codepoint_cnt, int type) {
+  font_data_t d = load_font_data_cached(path, size, codepoints, codepoint_cnt, type);
+  if (!d.font.glyphs) return GetFontDefault();
+  return load_font_texture(&d, LoadTextureFromImage(d.atlas));
+}
@@ -0,0 +1,184 @@
+// HIT TESTS
+// ray tests for each target shape, the rays come from the camera and
+// must have a normalized direction
+// each returns the distance along the ray to the hit or INFINITY
+
+float ray_cube(Ray r, Vector3 c, cube_t cube) {
+  Vector3 o = Vector3Subtract(r.position, c);
+  Vector3 h = Vector3Scale(cube.dims, 0.5f);
+  float *po = &o.x, *pd = &r.direction.x, *ph = &h.x;
+  float near = -INFINITY, far = INFINITY;
+  for (size_t k = 0; k < 3; ++k) {
+    float inv = 1.0f / pd[k];
+    float t0 = (-ph[k] - po[k]) * inv;
+    float t1 = ( ph[k] - po[k]) * inv;
+    if (t0 > t1) { float t = t0; t0 = t1; t1 = t; }
+    if (t0 > near) near = t0;
+    if (t1 < far) far = t1;
+  }
+  if (near > far || far < 0) return INFINITY;
+  return (near > 0) ? near : 0;
+}
+
+float ray_sphere(Ray r, Vector3 c, sphere_t sphere) {
+  Vector3 oc = Vector3Subtract(c, r.position);
+  float b = Vector3DotProduct(oc, r.direction);
+  float q = Vector3DotProduct(oc, oc) - sphere.radius * sphere.radius;
+  float disc = b * b - q;
+  if (disc < 0) return INFINITY;
+  float s = sqrtf(disc);
+  if (b + s < 0) return INFINITY;
+  return (b - s > 0) ? b - s : 0;
+}
+
+float ray_capsule(Ray r, Vector3 c, capsule_t cap) {
+  // against the infinite cylinder around the axis first
+  float hh = cap.half_height;
+  float rr = cap.radius * cap.radius;
+  Vector3 o = Vector3Subtract(r.position, c);
+  Vector3 d = r.direction;
+  // axis is y so everything reduces to the xz plane
+  float a = d.x * d.x + d.z * d.z;
+  float b = o.x * d.x + o.z * d.z;
+  float q = o.x * o.x + o.z * o.z - rr;
+  if (a > 1e-8f) {
+    float disc = b * b - a * q;
+    if (disc < 0) return INFINITY;
+    float t = (-b - sqrtf(disc)) / a;
+    float y = o.y + t * d.y;
+    if (t >= 0 && y >= -hh && y <= hh) return t;
+  }
+  // then the caps
+  sphere_t s = { cap.radius };
+  float top = ray_sphere(r, (Vector3) { c.x, c.y + hh, c.z }, s);
+  float bot = ray_sphere(r, (Vector3) { c.x, c.y - hh, c.z }, s);
+  return (top < bot) ? top : bot;
+}
+
+float ray_hitbox(Ray r, Vector3 c, const hitbox_t *h) {
+  c = Vector3Add(c, h->offset);
+  switch (h->shape) {
+  case TT_CUBE:    return ray_cube(r, c, h->cube);
+  case TT_SPHERE:  return ray_sphere(r, c, h->sphere);
+  case TT_CAPSULE: return ray_capsule(r, c, h->capsule);
+  default: assert(false && "UNREACHABLE");
+  }
+  return INFINITY;
+}
+
+float ray_obb(Ray r, Vector3 c, const obb_t *b) {
+  Vector3 o = Vector3Subtract(r.position, Vector3Add(c, b->center));
+  // into the frame of the box
+  Ray local = {
+    .position = {
+      Vector3DotProduct(o, b->axes[0]),
+      Vector3DotProduct(o, b->axes[1]),
+      Vector3DotProduct(o, b->axes[2]),
+    },
+    .direction = {
+      Vector3DotProduct(r.direction, b->axes[0]),
+      Vector3DotProduct(r.direction, b->axes[1]),
+      Vector3DotProduct(r.direction, b->axes[2]),
+    },
+  };
+  cube_t cube = { .dims = Vector3Scale(b->half, 2) };
+  return ray_cube(local, Vector3Zero(), cube);
+}
+
+// closest bone box, writes its damage multiplier
+float ray_animated(Ray r, Vector3 c, const animated_t *a, float *multiplier) {
+  // bounds first, most rays miss the whole target
+  Vector3 bc = Vector3Add(c, Vector3Scale(Vector3Add(a->bounds.min, a->bounds.max), 0.5f));
+  cube_t bounds = { .dims = Vector3Subtract(a->bounds.max, a->bounds.min) };
+  if (ray_cube(r, bc, bounds) == INFINITY) return INFINITY;
+
+  const rig_t *rig = &rigs.data[a->rig];
+  float best = INFINITY;
+  for (size_t i = 0; i < rig->box_cnt; ++i) {
+    float t = ray_obb(r, c, &a->boxes[i]);
+    if (t < best) {
+      best = t;
+      *multiplier = rig->boxes[i].head ? a->head_multiplier : 1;
+    }
+  }
+  return best;
+}
+
+// closest part, writes its damage multiplier
+float ray_compound(Ray r, Vector3 c, const compound_t *compound, float *multiplier) {
+  float best = INFINITY;
+  for (size_t i = 0; i < compound->len; ++i) {
+    float t = ray_hitbox(r, c, &compound->parts[i]);
+    if (t < best) {
+      best = t;
+      *multiplier = compound->parts[i].multiplier;
+    }
+  }
+  return best;
+}
+
+// for tests that aren't worth specializing, c overrides the position
+float ray_target(Ray r, Vector3 c, const target_t *t, float *multiplier) {
+  *multiplier = 1;
+  switch (t->shape) {
+  case TT_CUBE:     return ray_cube(r, c, t->cube);
+  case TT_SPHERE:   return ray_sphere(r, c, t->sphere);
+  case TT_CAPSULE:  return ray_capsule(r, c, t->capsule);
+  case TT_COMPOUND: return ray_compound(r, c, &t->compound, multiplier);
+  case TT_ANIMATED: return ray_animated(r, c, &t->animated, multiplier);
+  default: assert(false && "UNREACHABLE");
+  }
+  return INFINITY;
+}
+
+// the basic shapes as a hitbox with no offset
+hitbox_t target_hitbox(const target_t *t) {
+  hitbox_t h = { .shape = t->shape, .multiplier = 1 };
+  switch (t->shape) {
+  case TT_CUBE:    { h.cube = t->cube;       break; }
+  case TT_SPHERE:  { h.sphere = t->sphere;   break; }
+  case TT_CAPSULE: { h.capsule = t->capsule; break; }
+  default: assert(false && "UNREACHABLE");
+  }
+  return h;
+}
+
+Vector3 hitbox_half_extents(const hitbox_t *h) {
+  switch (h->shape) {
+  case TT_CUBE:    return Vector3Scale(h->cube.dims, 0.5f);
+  case TT_SPHERE:  return (Vector3) { h->sphere.radius, h->sphere.radius, h->sphere.radius };
+  case TT_CAPSULE: {
+    float r = h->capsule.radius;
+    return (Vector3) { r, r + h->capsule.half_height, r };
+  }
+  default: assert(false && "UNREACHABLE");
+  }
+  return Vector3Zero();
+}
+
+// bounding box around the target position, for the cheap broad tests
+BoundingBox target_bounds(const target_t *t, Vector3 c) {
+  BoundingBox b;
+  if (t->shape == TT_COMPOUND) {
+    b.min = (Vector3) { INFINITY, INFINITY, INFINITY };
+    b.max = (Vector3) { -INFINITY, -INFINITY, -INFINITY };
+    for (size_t i = 0; i < t->compound.len; ++i) {
+      const hitbox_t *h = &t->compound.parts[i];
+      Vector3 e = hitbox_half_extents(h);
+      Vector3 p = Vector3Add(c, h->offset);
+      b.min = Vector3Min(b.min, Vector3Subtract(p, e));
+      b.max = Vector3Max(b.max, Vector3Add(p, e));
+    }
+    return b;
+  }
+  if (t->shape == TT_ANIMATED) {
+    b.min = Vector3Add(c, t->animated.bounds.min);
+    b.max = Vector3Add(c, t->animated.bounds.max);
+    return b;
+  }
+  hitbox_t h = target_hitbox(t);
+  Vector3 e = hitbox_half_extents(&h);
+  b.min = Vector3Subtract(c, e);
+  b.max = Vector3Add(c, e);
+  return b;
+}
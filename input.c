@@ -0,0 +1,119 @@
+// INPUT
+// timestamped input events, filled once per frame from the cursor
+// samples raylib registers and consumed by the simulation (see sim.c)
+
+#define INPUT_QUEUE_CAP 1024
+
+typedef enum {
+  IE_MOUSE_MOVE,
+  IE_FIRE_DOWN,
+  IE_FIRE_UP,
+  IE_CNT
+} input_event_e;
+
+typedef struct {
+  double time;
+  input_event_e type;
+  // mouse counts moved since the previous move event
+  Vector2 delta;
+} input_event_t;
+
+// ring buffer
+struct {
+  input_event_t data[INPUT_QUEUE_CAP];
+  size_t head;
+  size_t len;
+  // time of the previous input_poll
+  double last_poll;
+  // fire button state at the previous input_poll
+  bool fire_down;
+  // cursor position of the last sample, deltas are taken from it
+  // NOTE: the cursor is disabled in game so this is raw counts with
+  // no window edge, exact while it stays within float integers (2^24)
+  Vector2 last_position;
+} input_queue;
+
+void input_reset(double now) {
+  input_queue.head = 0;
+  input_queue.len = 0;
+  input_queue.last_poll = now;
+  input_queue.fire_down = false;
+  input_queue.last_position = GetMousePosition();
+}
+
+// drops the oldest event when full
+void input_push(input_event_t e) {
+  if (input_queue.len == INPUT_QUEUE_CAP) {
+    input_queue.head = (input_queue.head + 1) % INPUT_QUEUE_CAP;
+    input_queue.len--;
+  }
+  size_t i = (input_queue.head + input_queue.len) % INPUT_QUEUE_CAP;
+  input_queue.data[i] = e;
+  input_queue.len++;
+}
+
+// returns false if the queue is empty
+bool input_peek(input_event_t *e) {
+  if (input_queue.len == 0) return false;
+  *e = input_queue.data[input_queue.head];
+  return true;
+}
+
+void input_pop(void) {
+  assert(input_queue.len > 0 && "POPPING FROM EMPTY INPUT QUEUE");
+  input_queue.head = (input_queue.head + 1) % INPUT_QUEUE_CAP;
+  input_queue.len--;
+}
+
+// sum of the mouse deltas still in the queue
+Vector2 input_pending_delta(void) {
+  Vector2 d = Vector2Zero();
+  for (size_t i = 0; i < input_queue.len; ++i) {
+    const input_event_t *e = &input_queue.data[(input_queue.head + i) % INPUT_QUEUE_CAP];
+    if (e->type == IE_MOUSE_MOVE) d = Vector2Add(d, e->delta);
+  }
+  return d;
+}
+
+void input_push_move(double time, Vector2 position) {
+  Vector2 d = Vector2Subtract(position, input_queue.last_position);
+  input_queue.last_position = position;
+  if (d.x == 0 && d.y == 0) return;
+  // input offset: holding space moves the mouse/pen without turning, to
+  // recenter it on the pad, the movement is dropped
+  if (IsKeyDown(KEY_SPACE)) return;
+  input_push((input_event_t) {
+      .time = time,
+      .type = IE_MOUSE_MOVE,
+      .delta = d,
+    });
+}
+
+// pushes everything that happened since the last poll
+void input_poll(double now) {
+  int n = GetMouseSampleCount();
+  double dt = now - input_queue.last_poll;
+  // NOTE: glfw only hands us the samples when the events are polled
+  // so they all carry (almost) the same time, spread them evenly
+  // over the frame instead - order is kept which is what matters
+  for (int i = 0; i < n; ++i) {
+    MouseSample s = GetMouseSample(i);
+    input_push_move(input_queue.last_poll + dt * (i + 1) / n, s.position);
+  }
+  // platforms without cursor samples only give us the latest position
+  if (n == 0) {
+    input_push_move(now, GetMousePosition());
+  }
+
+  // fire is held with M1 or A
+  // NOTE: buttons are only known per frame, so presses get the poll time
+  bool fire_down = IsMouseButtonDown(MOUSE_BUTTON_LEFT) || IsKeyDown(KEY_A);
+  if (fire_down != input_queue.fire_down) {
+    input_push((input_event_t) {
+	.time = now,
+	.type = fire_down ? IE_FIRE_DOWN : IE_FIRE_UP,
+      });
+    input_queue.fire_down = fire_down;
+  }
+  input_queue.last_poll = now;
+}
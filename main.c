@@ -4,12 +4,23 @@
 #include <assert.h>
 #include "raylib-5.0/src/raylib.h"
 #include "raylib-5.0/src/raymath.h"
+#include "raylib-5.0/src/rlgl.h"
 
 // the smartest idea ever
 // order is important :D
 #include "xml.c"
 #include "settings.c"
+#include "rig.c"
 #include "scenario.c"
+#include "hitbox.c"
+#include "aim.c"
+#include "workers.c"
+#include "input.c"
+#include "sim.c"
+#include "dynfont.c"
+#include "ui.c"
+#include "fontcache.c"
+#include "assets.c"
 
 // TODO: scoring
 // TODO: local leaderboard
@@ -22,10 +33,21 @@
 // TODO: fullscreen
 //   NOTE: done? but just blackscreens - test offstream because it fks with monitor settings too
 // TODO: change input mode?
-// TODO: input offset to make resetting tablet position easier
 
 // UI BUTTONS
+// menus are drawn with deferred draws, boxes go on layer 0 and text on
+// layer 1 so every box and every string end up in one draw call each
+// widgets only draw while their screen is redrawn (see ui.c)
 
+#define UI_LAYER_BOX 0
+#define UI_LAYER_TEXT 1
+
+// menus and the HUD are 2d only so they go through their own batch
+// uploading 16 byte vertices instead of 24
+#define UI_BATCH_BUFFERS 3
+#define UI_BATCH_ELEMENTS 2048
+
+rlRenderBatch ui_batch;
 Font menu_font;
 
 // x, y are centre coords
@@ -33,9 +55,9 @@ Font menu_font;
 bool menu_button(const char *text, int x, int y) {
 
   float spacing = 2.5f;
-  Vector2 sz = MeasureTextEx(menu_font, text,
-			     menu_theme_settings.font_size,
-			     menu_theme_settings.font_spacing);
+  Vector2 sz = measure_text(menu_font, text,
+			    menu_theme_settings.font_size,
+			    menu_theme_settings.font_spacing);
   int pad = 10;
 
   x = x - sz.x/2;
@@ -47,11 +69,15 @@ bool menu_button(const char *text, int x, int y) {
     active = true;
   }
   
-  DrawRectangle(x, y, sz.x + pad*2, sz.y + pad*2, BLACK);
-  DrawTextEx(menu_font, text, (Vector2){x+pad, y+pad},
-	     menu_theme_settings.font_size,
-	     menu_theme_settings.font_spacing,
-	     menu_theme_settings.font_colour);
+  if (ui_drawing) {
+    rlSetDrawLayer(UI_LAYER_BOX);
+    DrawRectangle(x, y, sz.x + pad*2, sz.y + pad*2, BLACK);
+    rlSetDrawLayer(UI_LAYER_TEXT);
+    draw_text(menu_font, text, (Vector2){x+pad, y+pad},
+	      menu_theme_settings.font_size,
+	      menu_theme_settings.font_spacing,
+	      menu_theme_settings.font_colour);
+  }
   
   if (active && IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) return true;
   return false;
@@ -64,30 +90,37 @@ bool menu_button(const char *text, int x, int y) {
 bool entry_box(const char *label, int x, int y, str *out) {
   static bool active = false;
   float spacing = 2.5f;
-  Vector2 sz = MeasureTextEx(menu_font, label,
-			     menu_theme_settings.font_size,
-			     menu_theme_settings.font_spacing);
+  Vector2 sz = measure_text(menu_font, label,
+			    menu_theme_settings.font_size,
+			    menu_theme_settings.font_spacing);
   int pad = 10;  
 
   x = x - sz.x - pad;
   y = y - sz.y/2;
-  // label  
-  DrawRectangle(x, y, sz.x + pad*2, sz.y + pad*2, BLACK);
-  DrawTextEx(menu_font, label, (Vector2){x+pad, y+pad},
-	     menu_theme_settings.font_size,
-	     menu_theme_settings.font_spacing,
-	     menu_theme_settings.font_colour);
-
-  // entry box
-  DrawRectangle(x+sz.x+pad*2, y, sz.x + pad*2, sz.y + pad*2, (active) ? GREEN : RED);
-  // draw text
-  DrawTextEx(menu_font, out->data,
-	     (Vector2){x+sz.x+3*pad, y+pad},
-	     menu_theme_settings.font_size,
-	     menu_theme_settings.font_spacing,
-	     menu_theme_settings.font_colour);
+  if (ui_drawing) {
+    // label  
+    rlSetDrawLayer(UI_LAYER_BOX);
+    DrawRectangle(x, y, sz.x + pad*2, sz.y + pad*2, BLACK);
+    rlSetDrawLayer(UI_LAYER_TEXT);
+    draw_text(menu_font, label, (Vector2){x+pad, y+pad},
+	      menu_theme_settings.font_size,
+	      menu_theme_settings.font_spacing,
+	      menu_theme_settings.font_colour);
+
+    // entry box
+    rlSetDrawLayer(UI_LAYER_BOX);
+    DrawRectangle(x+sz.x+pad*2, y, sz.x + pad*2, sz.y + pad*2, (active) ? GREEN : RED);
+    // draw text
+    rlSetDrawLayer(UI_LAYER_TEXT);
+    draw_text(menu_font, out->data,
+	      (Vector2){x+sz.x+3*pad, y+pad},
+	      menu_theme_settings.font_size,
+	      menu_theme_settings.font_spacing,
+	      menu_theme_settings.font_colour);
+  }
 
   // update state
+  bool was_active = active;
   Vector2 m = GetMousePosition();
   if (m.x > x + sz.x + 2*pad &&
       m.x < x + 2*sz.x + pad * 4 &&
@@ -96,14 +129,17 @@ bool entry_box(const char *label, int x, int y, str *out) {
   } else if (active) {
     active = !IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
   }
+  if (active != was_active) ui_invalidate();
   if (active) {
     char x;
     if ((x = GetCharPressed()) > 0) {
       str_append(out, x);
+      ui_invalidate();
     }
     int key_press = GetKeyPressed();
     if (key_press == KEY_BACKSPACE) {
       out->data[--out->len] = '\0';
+      ui_invalidate();
     }
     if (key_press == KEY_ENTER) {
       return true;
@@ -113,23 +149,8 @@ bool entry_box(const char *label, int x, int y, str *out) {
   return false;
 }
 
-// assumes normalized view vector
-void set_camera_rotation(Camera *camera, Vector2 mouse_position) {
-  Vector2 angles;
-  // Y = 0..height -> -PI..PI
-  // and invert
-  angles.y = -(float)mouse_position.y / global_settings.height * 2 * M_PI + M_PI;
-  // X = 0..width -> 0..2*PI
-  // and invert
-  angles.x = -(float)mouse_position.x / global_settings.width * 2 * M_PI;
-  // FIXME: sensitivity only makes sensse >1 for now
-  // NOTE: resetting mouse position without changing view angle
-  // (see input offset above)
-  //angles.x *= global_settings.sensitivity;
-  //angles.y *= global_settings.sensitivity;
-  Vector3 view_zero = (Vector3) {0, 0, 1};
-  Matrix m = MatrixRotateXYZ((Vector3){angles.y, angles.x, 0});
-  Vector3 view_dir = Vector3Transform(view_zero, m);
+void set_camera_rotation(Camera *camera, aim_t aim) {
+  Vector3 view_dir = aim_dir(aim);
   camera->target = (Vector3) {
     camera->position.x + view_dir.x,
     camera->position.y + view_dir.y,
@@ -137,65 +158,120 @@ void set_camera_rotation(Camera *camera, Vector2 mouse_position) {
   };
 }
 
-void initialize_cubes(size_t n, cube_t cubes[static n]) {
-  for (size_t i = 0; i < n; ++i) {
-    float x = (float)rand() / RAND_MAX * 2 - 1;
-    float y = (float)rand() / RAND_MAX * 2 - 1;
-    float z = -2;
-    cubes[i].position = (Vector3){ x, y, z };
-
-    cubes[i].dims = (Vector3) {0.1, 0.1, 0.1};
-    Vector3 d = cubes[i].dims;
-
-    BoundingBox b;
-    b.min.x = x - d.x/2;
-    b.min.y = y - d.y/2;
-    b.min.z = z - d.z/2;
-    b.max.x = x + d.x/2;
-    b.max.y = y + d.y/2;
-    b.max.z = z + d.z/2;
-    cubes[i].bbox = b;
+void draw_hitbox(Vector3 p, const hitbox_t *h, Color colour) {
+  switch (h->shape) {
+  case TT_CUBE: {
+    Vector3 d = h->cube.dims;
+    DrawCube(p, d.x, d.y, d.z, colour);
+    break;
+  }
+  case TT_SPHERE: {
+    DrawSphere(p, h->sphere.radius, colour);
+    break;
+  }
+  case TT_CAPSULE: {
+    Vector3 up = { 0, h->capsule.half_height, 0 };
+    DrawCapsule(Vector3Subtract(p, up), Vector3Add(p, up),
+		h->capsule.radius, 16, 8, colour);
+    break;
+  }
+  default: assert(false && "UNREACHABLE");
   }
 }
 
-size_t check_collision(Ray r, size_t n, cube_t cubes[static n]) {
-  RayCollision rc;
-  for (size_t i = 0; i < n; ++i) {
-    rc = GetRayCollisionBox(r, cubes[i].bbox);
-    if (rc.hit) return i;
+// SKINNING
+// animated targets are skinned on the workers each frame, all into one
+// buffer, then every mesh is uploaded and drawn in turn
+// the simulation never needs this, it only poses the bone boxes
+
+struct {
+  float *data;
+  size_t cap;
+  // animated targets drawn this frame and where their vertices start
+  size_t targets[TARGET_CAP];
+  size_t offsets[TARGET_CAP];
+  size_t len;
+} skins;
+
+void skin_targets_range(void *ctx, size_t begin, size_t end) {
+  const sim_view_t *v = ctx;
+  for (size_t i = begin; i < end; ++i) {
+    size_t t = skins.targets[i];
+    const animated_t *a = &v->templates[t]->animated;
+    rig_skin(&rigs.data[a->rig], a->anim, v->anim_times[t], a->height, &skins.data[skins.offsets[i]]);
   }
-  return n;
 }
 
-void respawn_cube(size_t i, size_t n, cube_t cubes[static n]) {
-  float x = (float)rand() / RAND_MAX * 2 - 1;
-  float y = (float)rand() / RAND_MAX * 2 - 1;
-  float z = -2;
-  cubes[i].position = (Vector3){ x, y, z };
-
-  Vector3 d = cubes[i].dims;
-  BoundingBox b;
-  b.min.x = x - d.x/2;
-  b.min.y = y - d.y/2;
-  b.min.z = z - d.z/2;
-  b.max.x = x + d.x/2;
-  b.max.y = y + d.y/2;
-  b.max.z = z + d.z/2;
-
-  cubes[i].bbox = b;
+void skin_targets(const sim_view_t *v) {
+  size_t len = 0;
+  skins.len = 0;
+  for (size_t i = 0; i < v->target_cnt; ++i) {
+    if (v->templates[i]->shape != TT_ANIMATED) continue;
+    skins.targets[skins.len] = i;
+    skins.offsets[skins.len++] = len;
+    len += rig_skin_len(&rigs.data[v->templates[i]->animated.rig]);
+  }
+  if (len > skins.cap) {
+    skins.cap = len;
+    skins.data = realloc(skins.data, skins.cap * sizeof(*skins.data));
+    assert(skins.data && "REALLOC FAILED");
+  }
+  workers_for(skin_targets_range, (void *)v, skins.len, 1);
 }
 
-void draw_cubes(size_t n, cube_t cubes[static n]) {
+// draws the i-th skinned target at p
+// NOTE: the targets share the rig's buffers, each draw is issued before
+// the next upload overwrites them
+void draw_skinned(const sim_view_t *v, size_t i, Vector3 p) {
+  const animated_t *a = &v->templates[skins.targets[i]]->animated;
+  const Model *model = &rigs.data[a->rig].model;
+  const float *vertices = &skins.data[skins.offsets[i]];
+  Matrix transform = MatrixTranslate(p.x, p.y, p.z);
+  for (int k = 0; k < model->meshCount; ++k) {
+    Mesh mesh = model->meshes[k];
+    rlUpdateVertexBuffer(mesh.vboId[0], vertices, 3 * mesh.vertexCount * sizeof(float), 0);
+    DrawMesh(mesh, model->materials[model->meshMaterial[k]], transform);
+    vertices += 3 * mesh.vertexCount;
+  }
+}
+
+void unload_skins(void) {
+  free(skins.data);
+  skins.data = NULL;
+  skins.cap = 0;
+  skins.len = 0;
+}
+
+// targets alpha of the way from their previous to their last position
+void draw_targets(const sim_view_t *v, float alpha) {
   // wall TODO: remove hardcoding
   DrawCube((Vector3){0, 0, -2}, 2, 2, 0.05, GRAY);
 
-  for (size_t i = 0; i < n; ++i) {
-    Vector3 d = cubes[i].dims;
-    DrawCube(cubes[i].position, d.x, d.y, d.z, ORANGE);
+  skin_targets(v);
+  size_t skinned = 0;
+  for (size_t i = 0; i < v->target_cnt; ++i) {
+    const target_t *t = v->templates[i];
+    Vector3 p = Vector3Lerp(v->prev_positions[i], v->positions[i], alpha);
+    if (t->shape == TT_ANIMATED) {
+      draw_skinned(v, skinned++, p);
+      continue;
+    }
+    if (t->shape != TT_COMPOUND) {
+      hitbox_t h = target_hitbox(t);
+      draw_hitbox(p, &h, ORANGE);
+      continue;
+    }
+    for (size_t k = 0; k < t->compound.len; ++k) {
+      const hitbox_t *h = &t->compound.parts[k];
+      // weak spots stand out
+      Color colour = (h->multiplier > 1) ? RED : ORANGE;
+      draw_hitbox(Vector3Add(p, h->offset), h, colour);
+    }
   }
 }
 
 typedef enum {
+  GS_LOADING,
   GS_MENU,
   GS_GAMEPLAY,
   GS_GAMEOVER,
@@ -204,41 +280,55 @@ typedef enum {
   GS_CNT
 } game_state_e;
 
-
-#define CUBE_CNT 5
-
-cube_t cubes[CUBE_CNT];
 Texture2D crosshair;
-float time_remaining;
-float score;
 Font game_font;
 
+// static screens, redrawn when their widgets change
+ui_screen_t gameover_screen;
+ui_screen_t menu_screen;
+ui_screen_t options_screen;
+
 // draws time_remaining
 // draws score
-void draw_game_stats(void) {
+// NOTE: the text is only formatted again when the shown value changes,
+// measuring and laying it out is cached (see ui.c)
+void draw_game_stats(const sim_view_t *s) {
+  static long shown_time = -1, shown_score = -1;
+  static char time_text[32], score_text[32];
+  long t = lroundf(s->time_remaining * 100);
+  if (t != shown_time) {
+    snprintf(time_text, sizeof(time_text), "%.2f", s->time_remaining);
+    shown_time = t;
+  }
+  long score = lround(s->score);
+  if (score != shown_score) {
+    snprintf(score_text, sizeof(score_text), "%.0f", s->score);
+    shown_score = score;
+  }
+
   float pad = 10.f;
   // time remaining
-  char text[128];
-  snprintf(text, 128, "%.2f", time_remaining);
-  float spacing = 1.5f;
-  Vector2 sz = MeasureTextEx(game_font, text, 36, spacing);
-
-  DrawTextEx(game_font, text,
-	     (Vector2){global_settings.width/2 - sz.x/2, pad},
-	     scen_theme_settings.font_size,
-	     scen_theme_settings.font_spacing,
-	     scen_theme_settings.font_colour);
+  // NOTE: both change every frame, laid out from cached glyphs rather
+  // than cached as whole strings
+  const char *text = time_text;
+  Vector2 sz = measure_glyphs(game_font, text,
+			      scen_theme_settings.font_size,
+			      scen_theme_settings.font_spacing);
+  draw_glyphs(game_font, text,
+	      (Vector2){global_settings.width/2 - sz.x/2, pad},
+	      scen_theme_settings.font_size,
+	      scen_theme_settings.font_spacing,
+	      scen_theme_settings.font_colour);
   // score
-  snprintf(text, 128, "%.0f", score);
-
-  sz = MeasureTextEx(game_font, text,
-		     scen_theme_settings.font_size,
-		     scen_theme_settings.font_spacing);
-  DrawTextEx(game_font, text,
-	     (Vector2){global_settings.width - sz.x - pad, pad},
-	     scen_theme_settings.font_size,
-	     scen_theme_settings.font_spacing,
-	     scen_theme_settings.font_colour);
+  text = score_text;
+  sz = measure_glyphs(game_font, text,
+		      scen_theme_settings.font_size,
+		      scen_theme_settings.font_spacing);
+  draw_glyphs(game_font, text,
+	      (Vector2){global_settings.width - sz.x - pad, pad},
+	      scen_theme_settings.font_size,
+	      scen_theme_settings.font_spacing,
+	      scen_theme_settings.font_colour);
 }
 
 game_state_e update_gameplay(void) {
@@ -250,41 +340,52 @@ game_state_e update_gameplay(void) {
     .projection = CAMERA_PERSPECTIVE,
   };
 
-  time_remaining -= GetFrameTime();
-  if (time_remaining <= 0) {
-    ShowCursor();
-    return GS_GAMEOVER;
+  double now = GetTime();
+  // snapshot of the simulation to render from
+  static sim_view_t view;
+  // movement polled but not simulated yet
+  Vector2 pending;
+  pthread_mutex_lock(&sim_lock);
+  {
+    input_poll(now);
+    if (!global_settings.sim_threaded) {
+      sim_advance(&sim, now);
+    }
+    sim_view(&sim, &view);
+    pending = input_pending_delta();
   }
-  
-  Vector2 mouse_position = GetMousePosition();
-
-  set_camera_rotation(&camera, GetMousePosition());
+  pthread_mutex_unlock(&sim_lock);
 
-  if (IsKeyPressed(KEY_A)) {
-    Ray r = GetMouseRay((Vector2){global_settings.width/2,
-				  global_settings.height/2}, camera);
-    size_t i = check_collision(r, CUBE_CNT, cubes);
-    if (i < CUBE_CNT) {
-      score += 1;
-      respawn_cube(i, CUBE_CNT, cubes);
-    }
+  if (view.done) {
+    sim_stop();
+    EnableCursor();
+    // new score
+    gameover_screen.dirty = true;
+    return GS_GAMEOVER;
   }
 
+  // the camera includes the latest movement rather than stopping at the
+  // last simulated step so the view has no added latency
+  set_camera_rotation(&camera, aim_turn(view.aim, pending));
+
   BeginDrawing();
   {
     ClearBackground(RAYWHITE);
       
     BeginMode3D(camera);
     {
-      draw_cubes(CUBE_CNT, cubes);
+      draw_targets(&view, sim_alpha(&view, now));
     }
     EndMode3D();
 
+    rlSetRenderBatchActive(&ui_batch);
+
     DrawTexture(crosshair, global_settings.width/2 - crosshair.width/2,
 		global_settings.height/2 - crosshair.height/2, WHITE);
 
-    draw_game_stats();
+    draw_game_stats(&view);
     DrawFPS(0, 0);
+    rlSetRenderBatchActive(NULL);
   }
   EndDrawing();
 
@@ -295,27 +396,44 @@ game_state_e update_gameover(void) {
   game_state_e ns = GS_GAMEOVER;
   BeginDrawing();
   ClearBackground(RAYWHITE);
-
-  // draw score
-  char text[128];
-  snprintf(text, 128, "%.0f", score);
-  Vector2 dims = MeasureTextEx(menu_font, text,
-			       menu_theme_settings.font_size,
-			       menu_theme_settings.font_spacing);
-  Vector2 pos = {
-    global_settings.width/2  - dims.x/2,
-    global_settings.height/2 - dims.y/2
-  };
-  DrawTextEx(menu_font, text, pos,
-	     menu_theme_settings.font_size,
-	     menu_theme_settings.font_spacing,
-	     BLACK);
+  rlSetRenderBatchActive(&ui_batch);
+  rlEnableDeferredDraws();
+  ui_screen_begin(&gameover_screen, RAYWHITE);
+
+  if (ui_drawing) {
+    // draw score
+    char text[128];
+    snprintf(text, 128, "%.0f", sim.score);
+    Vector2 dims = measure_text(menu_font, text,
+				menu_theme_settings.font_size,
+				menu_theme_settings.font_spacing);
+    Vector2 pos = {
+      global_settings.width/2  - dims.x/2,
+      global_settings.height/2 - dims.y/2
+    };
+    draw_text(menu_font, text, pos,
+	      menu_theme_settings.font_size,
+	      menu_theme_settings.font_spacing,
+	      BLACK);
+    // flicks that went over a target without landing on it
+    snprintf(text, 128, "overflicks: %zu", sim.pass_cnt);
+    dims = measure_text(menu_font, text,
+			menu_theme_settings.font_size,
+			menu_theme_settings.font_spacing);
+    draw_text(menu_font, text,
+	      (Vector2){global_settings.width/2 - dims.x/2, pos.y + dims.y},
+	      menu_theme_settings.font_size,
+	      menu_theme_settings.font_spacing,
+	      BLACK);
+  }
   if (menu_button("Continue", global_settings.width/2, global_settings.height/2 + 100.)) {
     // TODO: save score somewhere
-    score = 0;
     ns = GS_MENU;
   }
   
+  ui_screen_end(&gameover_screen);
+  rlDisableDeferredDraws();
+  rlSetRenderBatchActive(NULL);
   EndDrawing();
 
   return ns;
@@ -325,10 +443,14 @@ game_state_e update_menu(void) {
   game_state_e ns = GS_MENU;
   BeginDrawing();
   ClearBackground(RAYWHITE);
+  rlSetRenderBatchActive(&ui_batch);
+  rlEnableDeferredDraws();
+  ui_screen_begin(&menu_screen, RAYWHITE);
   if (menu_button("Play", global_settings.width/2, global_settings.height/2)) {
-    initialize_cubes(CUBE_CNT, cubes);
-    HideCursor();
-    time_remaining = 5.f;
+    // raw counts with no window edge to stop at
+    DisableCursor();
+    assert(scenarios.len > 0 && "NO SCENARIO LOADED");
+    sim_start(&scenarios.data[0], GetTime());
     ns = GS_GAMEPLAY;
   }
   if (menu_button("Options", global_settings.width/2, global_settings.height/2 + 80)) {
@@ -337,7 +459,10 @@ game_state_e update_menu(void) {
   if (menu_button("Quit", global_settings.width/2, global_settings.height/2 + 160)) {
     ns = GS_QUIT;
   }
+  ui_screen_end(&menu_screen);
   DrawFPS(0, 0);
+  rlDisableDeferredDraws();
+  rlSetRenderBatchActive(NULL);
   EndDrawing();
   return ns;
 }
@@ -345,6 +470,9 @@ game_state_e update_menu(void) {
 game_state_e update_options(void) {
   BeginDrawing();
   ClearBackground(RAYWHITE);
+  rlSetRenderBatchActive(&ui_batch);
+  rlEnableDeferredDraws();
+  ui_screen_begin(&options_screen, RAYWHITE);
   float pad = 100.f;
   if (menu_button("Apply", global_settings.width/2, pad)) {
     printf("Applied :3\n");
@@ -353,31 +481,196 @@ game_state_e update_options(void) {
   if (entry_box("Target FPS", global_settings.width/2, 2*pad, &global_settings.desired_fps_str)) {
   }
   
+  ui_screen_end(&options_screen);
   DrawFPS(0, 0);
+  rlDisableDeferredDraws();
+  rlSetRenderBatchActive(NULL);
   EndDrawing();
   return GS_OPTIONS;
 }
 
-void load_fonts(void) {
-  if (menu_theme_settings.font_path) {
-    printf("Loading font from %s...\n", menu_theme_settings.font_path);
-    menu_font = LoadFontEx(menu_theme_settings.font_path, 512, NULL, 0);
-    assert(IsFontReady(menu_font) && "Font path specified is invalid or another font loading error has occurred");
+// bitmap glyphs are rasterized big so they stay sharp scaled down to the
+// theme font size, distance fields are sharp at any size from a small one
+#define FONT_BITMAP_SIZE 512
+#define FONT_SDF_SIZE 64
+
+// queues the theme's font into out, which is the default font until it
+// has loaded
+void load_theme_font(const theme_settings_t *theme, Font *out) {
+  *out = GetFontDefault();
+  if (!theme->font_path) return;
+  printf("Loading font from %s...\n", theme->font_path);
+  asset_t a = {
+    .path = theme->font_path,
+    .type = theme->font_sdf ? FONT_SDF : FONT_DEFAULT,
+    .font = out,
+  };
+  if (theme->font_dynamic) {
+    // bitmap glyphs come in as they are needed so they can be rasterized
+    // at the size they are drawn
+    a.kind = AK_DYN_FONT;
+    a.size = theme->font_sdf ? FONT_SDF_SIZE : theme->font_size;
   } else {
-    menu_font = GetFontDefault();
+    a.kind = AK_FONT;
+    a.size = theme->font_sdf ? FONT_SDF_SIZE : FONT_BITMAP_SIZE;
   }
-  if (scen_theme_settings.font_path) {
-    printf("Loading font from %s...\n", scen_theme_settings.font_path);
-    game_font = LoadFontEx(scen_theme_settings.font_path, 512, NULL, 0);
-    assert(IsFontReady(game_font) && "Font path specified is invalid or another font loading error has occurred");
+  asset_load(a);
+}
+
+// once it has loaded
+void finish_theme_font(const theme_settings_t *theme, Font font) {
+  assert(IsFontReady(font) && "Font path specified is invalid or another font loading error has occurred");
+  if (theme->font_sdf && font.texture.id != GetFontDefault().texture.id) add_sdf_font(font);
+}
+
+void load_fonts(void) {
+  load_theme_font(&menu_theme_settings, &menu_font);
+  load_theme_font(&scen_theme_settings, &game_font);
+}
+
+// HUD ATLAS
+// the white shapes texture, the crosshair and the game and default font
+// atlases packed in one texture, rlgl draws them from it so the HUD
+// doesn't switch textures between the crosshair, rectangles and text
+// NOTE: the menu font is left out, at 512px it would quadruple the atlas,
+// and so are sdf fonts which need their own shader and filtering and
+// dynamic fonts whose atlas keeps changing
+
+#define HUD_ATLAS_CAP 4
+#define HUD_ATLAS_PAD 2
+#define HUD_ATLAS_MAX_SIZE 4096
+
+Texture2D hud_atlas;
+
+// images are read back from the textures except for the ones passed in
+// NOTE: does nothing if the atlas would be too big, the textures are
+// still drawn on their own
+void load_hud_atlas(Image crosshair_image) {
+  unsigned int ids[HUD_ATLAS_CAP];
+  Image images[HUD_ATLAS_CAP];
+  size_t cnt = 0;
+  Texture2D textures[] = { GetFontDefault().texture, game_font.texture };
+
+  // shapes sample the centre of a white block, clear of any bleed
+  ids[cnt] = rlGetTextureIdDefault();
+  images[cnt++] = GenImageColor(4, 4, WHITE);
+  ids[cnt] = crosshair.id;
+  images[cnt++] = ImageCopy(crosshair_image);
+  for (size_t i = 0; i < sizeof(textures)/sizeof(*textures); ++i) {
+    bool seen = false;
+    for (size_t k = 0; k < cnt; ++k) seen |= (ids[k] == textures[i].id);
+    if (seen || is_sdf_texture(textures[i].id) || find_dyn_font(textures[i].id)) continue;
+    ids[cnt] = textures[i].id;
+    images[cnt++] = LoadImageFromTexture(textures[i]);
+  }
+
+  // shelves, tallest first
+  size_t order[HUD_ATLAS_CAP];
+  int area = 0, widest = 0;
+  for (size_t i = 0; i < cnt; ++i) {
+    size_t k = i;
+    for (; k > 0 && images[order[k - 1]].height < images[i].height; --k) order[k] = order[k - 1];
+    order[k] = i;
+    area += (images[i].width + HUD_ATLAS_PAD) * (images[i].height + HUD_ATLAS_PAD);
+    if (images[i].width + HUD_ATLAS_PAD > widest) widest = images[i].width + HUD_ATLAS_PAD;
+  }
+  int w = 64;
+  while (w < widest || w * w < area) w *= 2;
+
+  Rectangle recs[HUD_ATLAS_CAP];
+  int x = 0, y = 0, shelf = 0;
+  for (size_t i = 0; i < cnt; ++i) {
+    Image *im = &images[order[i]];
+    if (x + im->width + HUD_ATLAS_PAD > w) {
+      x = 0;
+      y += shelf;
+      shelf = 0;
+    }
+    recs[order[i]] = (Rectangle) { x, y, im->width, im->height };
+    x += im->width + HUD_ATLAS_PAD;
+    if (im->height + HUD_ATLAS_PAD > shelf) shelf = im->height + HUD_ATLAS_PAD;
+  }
+  int h = 64;
+  while (h < y + shelf) h *= 2;
+
+  if (w <= HUD_ATLAS_MAX_SIZE && h <= HUD_ATLAS_MAX_SIZE) {
+    Image atlas = GenImageColor(w, h, BLANK);
+    for (size_t i = 0; i < cnt; ++i) {
+      ImageDraw(&atlas, images[i], (Rectangle) { 0, 0, images[i].width, images[i].height }, recs[i], WHITE);
+    }
+    hud_atlas = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    recs[0] = (Rectangle) { recs[0].x + 1, recs[0].y + 1, 2, 2 };
+    for (size_t i = 0; i < cnt; ++i) {
+      rlSetTextureAlias(ids[i], hud_atlas.id,
+			recs[i].x / w, recs[i].y / h,
+			recs[i].width / w, recs[i].height / h);
+    }
   } else {
-    game_font = GetFontDefault();
+    printf("HUD atlas would be %dx%d, drawing textures on their own\n", w, h);
   }
+
+  for (size_t i = 0; i < cnt; ++i) UnloadImage(images[i]);
+}
+
+// drops the aliases too
+void unload_hud_atlas(void) {
+  if (IsTextureReady(hud_atlas)) UnloadTexture(hud_atlas);
+}
+
+// LOADING
+// shown while whatever was queued with asset_load comes in, then the game
+// goes on to loading_next
+// the window is up and drawing from the first frame, the scenario, fonts
+// and crosshair are decoded on the workers meanwhile
+
+game_state_e loading_next = GS_MENU;
+bool loaded_startup = false;
+Image crosshair_image;
+
+void load_startup_assets(void) {
+  asset_load((asset_t) { .kind = AK_SCENARIO, .path = "scen.xml" });
+  load_fonts();
+  asset_load((asset_t) {
+      .kind = AK_TEXTURE,
+      .path = "./crosshair.png",
+      .texture = &crosshair,
+      .image = &crosshair_image,
+    });
+}
+
+// the parts that need everything else loaded first
+void finish_startup_assets(void) {
+  finish_theme_font(&menu_theme_settings, menu_font);
+  finish_theme_font(&scen_theme_settings, game_font);
+  load_hud_atlas(crosshair_image);
+  UnloadImage(crosshair_image);
+  loaded_startup = true;
+}
+
+game_state_e update_loading(void) {
+  bool done = assets_update(ASSET_FRAME_BUDGET);
+
+  BeginDrawing();
+  ClearBackground(RAYWHITE);
+  // the theme fonts may not be here yet
+  const char *text = "Loading...";
+  int w = global_settings.width, h = global_settings.height;
+  DrawText(text, w/2 - MeasureText(text, 20)/2, h/2 - 30, 20, DARKGRAY);
+  DrawRectangle(w/4, h/2, w/2, 8, LIGHTGRAY);
+  DrawRectangle(w/4, h/2, (w/2) * assets_progress(), 8, DARKGRAY);
+  DrawFPS(0, 0);
+  EndDrawing();
+
+  if (!done) return GS_LOADING;
+  if (!loaded_startup) finish_startup_assets();
+  return loading_next;
 }
 
 int main(void) {
   load_settings();
-  load_scenario("scen.xml");
+  workers_init(global_settings.workers);
+  SetParallelForCallback(raylib_parallel_for);
   
   InitWindow(global_settings.width, global_settings.height, "Hello, world window");
   // TODO: change target FPS in settings
@@ -386,20 +679,20 @@ int main(void) {
     ToggleFullscreen();
   }
 
-  load_fonts();
+  ui_batch = rlLoadRenderBatchFormat(UI_BATCH_BUFFERS, UI_BATCH_ELEMENTS, RL_BATCH_VERTEX_COMPACT_2D);
+  load_startup_assets();
   
   Vector3 position = {0, 0, 0};
 
-  Image crosshair_image = LoadImage("./crosshair.png");
-  crosshair = LoadTextureFromImage(crosshair_image);
-  UnloadImage(crosshair_image);
-
   Ray r;
 
-  game_state_e cstate = GS_MENU;
+  game_state_e cstate = GS_LOADING;
   bool done = false;
   while (!WindowShouldClose() && !done) {
+    // glyphs drawn last frame can be evicted again (see dynfont.c)
+    dyn_fonts_frame();
     switch(cstate) {
+    case GS_LOADING:  { cstate = update_loading();  break; }
     case GS_MENU:     { cstate = update_menu();     break; }
     case GS_GAMEPLAY: { cstate = update_gameplay(); break; }
     case GS_GAMEOVER: { cstate = update_gameover(); break; }
@@ -409,10 +702,22 @@ int main(void) {
     }    
   }
   // FIXME this is bad
-  if (menu_theme_settings.font_path) {
+  if (menu_theme_settings.font_path && !find_dyn_font(menu_font.texture.id)) {
     UnloadFont(menu_font);
     free(menu_theme_settings.font_path);
   }
+  ui_screen_free(&gameover_screen);
+  ui_screen_free(&menu_screen);
+  ui_screen_free(&options_screen);
+  unload_text_cache();
+  unload_sdf_fonts();
+  unload_dyn_fonts();
+  unload_hud_atlas();
+  rlUnloadRenderBatch(ui_batch);
+  // a scenario may still be decoding if the window closed while loading
+  workers_free();
+  unload_skins();
+  unload_rigs();
   CloseWindow();
   return 0;
 }
@@ -84,6 +84,7 @@
 #define MAX_TOUCH_POINTS                8       // Maximum number of touch points supported
 #define MAX_KEY_PRESSED_QUEUE          16       // Maximum number of keys in the key input queue
 #define MAX_CHAR_PRESSED_QUEUE         16       // Maximum number of characters in the char input queue
+#define MAX_MOUSE_SAMPLE_QUEUE        256       // Maximum number of cursor samples registered between input polls
 
 #define MAX_DECOMPRESSION_SIZE         64       // Max size allocated for decompression in MB
 
@@ -100,7 +101,7 @@
 //#define RLGL_SHOW_GL_DETAILS_INFO              1
 
 //#define RL_DEFAULT_BATCH_BUFFER_ELEMENTS    4096    // Default internal render batch elements limits
-#define RL_DEFAULT_BATCH_BUFFERS               1      // Default number of batch buffers (multi-buffering)
+#define RL_DEFAULT_BATCH_BUFFERS               3      // Default number of batch buffers (multi-buffering), fenced and persistent mapped on OpenGL 3.3+ if supported
 #define RL_DEFAULT_BATCH_DRAWCALLS           256      // Default number of batch draw calls (by state changes: mode, texture)
 #define RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS     4      // Maximum number of textures units that can be activated on batch drawing (SetShaderValueTexture())
 
@@ -108,6 +109,8 @@
 
 #define RL_MAX_SHADER_LOCATIONS               32      // Maximum number of shader locations supported
 
+#define RL_MAX_TEXTURE_ALIASES                16      // Maximum number of textures aliased to an atlas region (rlSetTextureAlias())
+
 #define RL_CULL_DISTANCE_NEAR               0.01      // Default projection matrix near cull distance
 #define RL_CULL_DISTANCE_FAR              1000.0      // Default projection matrix far cull distance
 
@@ -216,6 +219,8 @@
 //------------------------------------------------------------------------------------
 #define MAX_MATERIAL_MAPS              12       // Maximum number of shader maps supported
 #define MAX_MESH_VERTEX_BUFFERS         7       // Maximum vertex buffers (VBO) per mesh
+#define MAX_MESH_BVH_LEAF_TRIANGLES     4       // Maximum triangles per mesh BVH leaf node, bigger leaves split by SAH cost
+#define MAX_GEOMETRY_TEMPLATES         16       // Maximum sphere/cylinder unit geometries cached by DrawSphereEx()/DrawCylinder()
 
 //------------------------------------------------------------------------------------
 // Module: raudio - Configuration Flags
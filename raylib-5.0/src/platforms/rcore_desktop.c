@@ -1001,6 +1001,8 @@ void EnableCursor(void)
 {
     glfwSetInputMode(platform.handle, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
 
+    if (glfwRawMouseMotionSupported()) glfwSetInputMode(platform.handle, GLFW_RAW_MOUSE_MOTION, GLFW_FALSE);
+
     // Set cursor position in the middle
     SetMousePosition(CORE.Window.screen.width/2, CORE.Window.screen.height/2);
 
@@ -1012,6 +1014,9 @@ void DisableCursor(void)
 {
     glfwSetInputMode(platform.handle, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 
+    // Unaccelerated mouse counts while the cursor is locked, if the platform provides them
+    if (glfwRawMouseMotionSupported()) glfwSetInputMode(platform.handle, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+
     // Set cursor position in the middle
     SetMousePosition(CORE.Window.screen.width/2, CORE.Window.screen.height/2);
 
@@ -1130,6 +1135,9 @@ void PollInputEvents(void)
     // Register previous mouse position
     CORE.Input.Mouse.previousPosition = CORE.Input.Mouse.currentPosition;
 
+    // Reset cursor samples registered
+    CORE.Input.Mouse.sampleQueueCount = 0;
+
     // Register previous touch states
     for (int i = 0; i < MAX_TOUCH_POINTS; i++) CORE.Input.Touch.previousTouchState[i] = CORE.Input.Touch.currentTouchState[i];
 
@@ -1775,6 +1783,15 @@ static void MouseCursorPosCallback(GLFWwindow *window, double x, double y)
     CORE.Input.Mouse.currentPosition.y = (float)y;
     CORE.Input.Touch.position[0] = CORE.Input.Mouse.currentPosition;
 
+    // Register cursor sample, NOTE: GLFW dispatches queued events on glfwPollEvents(),
+    // so time is the dispatch time, ordering of the samples is preserved
+    if (CORE.Input.Mouse.sampleQueueCount < MAX_MOUSE_SAMPLE_QUEUE)
+    {
+        CORE.Input.Mouse.sampleQueue[CORE.Input.Mouse.sampleQueueCount].time = glfwGetTime();
+        CORE.Input.Mouse.sampleQueue[CORE.Input.Mouse.sampleQueueCount].position = CORE.Input.Mouse.currentPosition;
+        CORE.Input.Mouse.sampleQueueCount++;
+    }
+
 #if defined(SUPPORT_GESTURES_SYSTEM) && defined(SUPPORT_MOUSE_GESTURES)
     // Process mouse events as touches to be able to use mouse-gestures
     GestureEvent gestureEvent = { 0 };
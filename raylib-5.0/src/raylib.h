@@ -309,6 +309,7 @@ typedef struct Font {
     Texture2D texture;      // Texture atlas containing the glyphs
     Rectangle *recs;        // Rectangles in texture for the glyphs
     GlyphInfo *glyphs;      // Glyphs info data
+    int *glyphLookup;       // Glyphs index lookup table (codepoint -> index), NULL to search glyphs
 } Font;
 
 // Camera, defines position/orientation in 3d space
@@ -330,6 +331,10 @@ typedef struct Camera2D {
     float zoom;             // Camera zoom (scaling), should be 1.0f by default
 } Camera2D;
 
+// Opaque structs declaration
+// NOTE: Actual struct is defined internally in rmodels module
+typedef struct rMeshBVH rMeshBVH;
+
 // Mesh, vertex data and vao/vbo
 typedef struct Mesh {
     int vertexCount;        // Number of vertices stored in arrays
@@ -350,6 +355,9 @@ typedef struct Mesh {
     unsigned char *boneIds; // Vertex bone ids, max 255 bone ids, up to 4 bones influence by vertex (skinning)
     float *boneWeights;     // Vertex bone weight, up to 4 bones influence by vertex (skinning)
 
+    // Collision data
+    rMeshBVH *bvh;          // Bounding volume hierarchy for ray collision (optional, GenMeshBVH())
+
     // OpenGL identifiers
     unsigned int vaoId;     // OpenGL Vertex Array Object id
     unsigned int *vboId;    // OpenGL Vertex Buffer Objects id (default vertex data)
@@ -427,6 +435,17 @@ typedef struct RayCollision {
     Vector3 normal;         // Surface normal of hit
 } RayCollision;
 
+// CameraRayState, camera view/projection reduced to a basis for screen-space ray queries
+typedef struct CameraRayState {
+    Vector3 position;       // Camera position
+    Vector3 forward;        // Camera forward direction (normalized)
+    Vector3 right;          // Camera right direction, scaled to half the view width (at distance 1 for perspective)
+    Vector3 up;             // Camera up direction, scaled to half the view height (at distance 1 for perspective)
+    float width;            // Screen width the state was computed for
+    float height;           // Screen height the state was computed for
+    int projection;         // Camera projection: CAMERA_PERSPECTIVE or CAMERA_ORTHOGRAPHIC
+} CameraRayState;
+
 // BoundingBox
 typedef struct BoundingBox {
     Vector3 min;            // Minimum vertex box-corner
@@ -520,6 +539,12 @@ typedef struct AutomationEventList {
     AutomationEvent *events;        // Events entries
 } AutomationEventList;
 
+// Mouse sample, cursor position registered by the platform between input polls
+typedef struct MouseSample {
+    double time;                    // Time the sample was registered (GetTime() base)
+    Vector2 position;               // Cursor position
+} MouseSample;
+
 //----------------------------------------------------------------------------------
 // Enumerators Definition
 //----------------------------------------------------------------------------------
@@ -936,6 +961,8 @@ typedef unsigned char *(*LoadFileDataCallback)(const char *fileName, int *dataSi
 typedef bool (*SaveFileDataCallback)(const char *fileName, void *data, int dataSize);   // FileIO: Save binary data
 typedef char *(*LoadFileTextCallback)(const char *fileName);            // FileIO: Load text data
 typedef bool (*SaveFileTextCallback)(const char *fileName, char *text); // FileIO: Save text data
+typedef void (*ParallelWorkCallback)(void *userData, int begin, int end);   // Parallel: Process items [begin, end) of a job
+typedef void (*ParallelForCallback)(ParallelWorkCallback work, void *userData, int count); // Parallel: Run work over [0, count), on any threads, returning once done
 
 //------------------------------------------------------------------------------------
 // Global Variables Definition
@@ -1046,6 +1073,9 @@ RLAPI void UnloadShader(Shader shader);                                    // Un
 
 // Screen-space-related functions
 RLAPI Ray GetMouseRay(Vector2 mousePosition, Camera camera);      // Get a ray trace from mouse position
+RLAPI CameraRayState GetCameraRayState(Camera camera, int width, int height); // Get camera state for ray queries, reuse it while the camera does not change
+RLAPI Ray GetCameraRay(CameraRayState state, Vector2 position);   // Get a ray trace from screen position using camera state
+RLAPI void GetCameraRays(CameraRayState state, const Vector2 *positions, Ray *rays, int count); // Get ray traces from multiple screen positions using camera state
 RLAPI Matrix GetCameraMatrix(Camera camera);                      // Get camera transform matrix (view matrix)
 RLAPI Matrix GetCameraMatrix2D(Camera2D camera);                  // Get camera 2d transform matrix
 RLAPI Vector2 GetWorldToScreen(Vector3 position, Camera camera);  // Get the screen space position for a 3d world space position
@@ -1093,6 +1123,7 @@ RLAPI void SetLoadFileDataCallback(LoadFileDataCallback callback); // Set custom
 RLAPI void SetSaveFileDataCallback(SaveFileDataCallback callback); // Set custom file binary data saver
 RLAPI void SetLoadFileTextCallback(LoadFileTextCallback callback); // Set custom file text data loader
 RLAPI void SetSaveFileTextCallback(SaveFileTextCallback callback); // Set custom file text data saver
+RLAPI void SetParallelForCallback(ParallelForCallback callback);   // Set custom parallel for, used to rasterize font glyphs on LoadFontData()
 
 // Files management functions
 RLAPI unsigned char *LoadFileData(const char *fileName, int *dataSize); // Load file data as byte array (read)
@@ -1177,6 +1208,8 @@ RLAPI int GetMouseX(void);                                    // Get mouse posit
 RLAPI int GetMouseY(void);                                    // Get mouse position Y
 RLAPI Vector2 GetMousePosition(void);                         // Get mouse position XY
 RLAPI Vector2 GetMouseDelta(void);                            // Get mouse delta between frames
+RLAPI int GetMouseSampleCount(void);                          // Get number of cursor samples registered in the last input poll
+RLAPI MouseSample GetMouseSample(int index);                  // Get cursor sample registered in the last input poll (oldest first)
 RLAPI void SetMousePosition(int x, int y);                    // Set mouse position XY
 RLAPI void SetMouseOffset(int offsetX, int offsetY);          // Set mouse offset
 RLAPI void SetMouseScale(float scaleX, float scaleY);         // Set mouse scaling
@@ -1427,6 +1460,7 @@ RLAPI Font LoadFontFromMemory(const char *fileType, const unsigned char *fileDat
 RLAPI bool IsFontReady(Font font);                                                          // Check if a font is ready
 RLAPI GlyphInfo *LoadFontData(const unsigned char *fileData, int dataSize, int fontSize, int *codepoints, int codepointCount, int type); // Load font data for further use
 RLAPI Image GenImageFontAtlas(const GlyphInfo *glyphs, Rectangle **glyphRecs, int glyphCount, int fontSize, int padding, int packMethod); // Generate image font atlas using chars info
+RLAPI int *LoadFontGlyphLookup(const GlyphInfo *glyphs, int glyphCount);                    // Load font glyphs lookup table (codepoint -> index), for fonts built from data
 RLAPI void UnloadFontData(GlyphInfo *glyphs, int glyphCount);                               // Unload font chars info data (RAM)
 RLAPI void UnloadFont(Font font);                                                           // Unload font from GPU memory (VRAM)
 RLAPI bool ExportFontAsCode(Font font, const char *fileName);                               // Export font as code file, returns true on success
@@ -1533,6 +1567,7 @@ RLAPI void DrawMeshInstanced(Mesh mesh, Material material, const Matrix *transfo
 RLAPI bool ExportMesh(Mesh mesh, const char *fileName);                                     // Export mesh data to file, returns true on success
 RLAPI BoundingBox GetMeshBoundingBox(Mesh mesh);                                            // Compute mesh bounding box limits
 RLAPI void GenMeshTangents(Mesh *mesh);                                                     // Compute mesh tangents
+RLAPI void GenMeshBVH(Mesh *mesh);                                                          // Compute mesh bounding volume hierarchy, speeds up GetRayCollisionMesh()
 
 // Mesh generation functions
 RLAPI Mesh GenMeshPoly(int sides, float radius);                                            // Generate polygonal mesh
@@ -27,6 +27,15 @@
 *           Define static inline functions code, so #include header suffices for use.
 *           This may use up lots of memory.
 *
+*       #define RAYMATH_SIMD
+*           Use SSE2 (x86) or NEON (ARM) intrinsics for the matrix functions that benefit from them:
+*           MatrixTranspose() on both, MatrixInvert() on SSE2 only. Transposes are bit identical to the
+*           scalar versions, inverses match them within float rounding (checked by tests/raymath_simd.c).
+*           Ignored on targets supporting neither.
+*           NOTE: There is no NEON MatrixInvert(), ARM builds keep the scalar inverse
+*           NOTE: MatrixMultiply() stays scalar, compilers already vectorize it at -O2
+*           NOTE: Define it for every file including raymath, the API does not change
+*
 *
 *   LICENSE: zlib/libpng
 *
@@ -75,6 +84,17 @@
     #endif
 #endif
 
+// SIMD backend selection, see RAYMATH_SIMD
+#if defined(RAYMATH_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #include <emmintrin.h>      // Required for: SSE2 intrinsics
+        #define RAYMATH_SIMD_SSE
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>       // Required for: NEON intrinsics
+        #define RAYMATH_SIMD_NEON
+    #endif
+#endif
+
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
@@ -1174,6 +1194,28 @@ RMAPI Matrix MatrixTranspose(Matrix mat)
 {
     Matrix result = { 0 };
 
+#if defined(RAYMATH_SIMD_SSE)
+    // NOTE: Each struct row (m0, m4, m8, m12) is contiguous in memory
+    __m128 row0 = _mm_loadu_ps(&mat.m0);
+    __m128 row1 = _mm_loadu_ps(&mat.m1);
+    __m128 row2 = _mm_loadu_ps(&mat.m2);
+    __m128 row3 = _mm_loadu_ps(&mat.m3);
+
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    _mm_storeu_ps(&result.m0, row0);
+    _mm_storeu_ps(&result.m1, row1);
+    _mm_storeu_ps(&result.m2, row2);
+    _mm_storeu_ps(&result.m3, row3);
+#elif defined(RAYMATH_SIMD_NEON)
+    // Interleaved load reads the matrix already transposed
+    float32x4x4_t rows = vld4q_f32(&mat.m0);
+
+    vst1q_f32(&result.m0, rows.val[0]);
+    vst1q_f32(&result.m1, rows.val[1]);
+    vst1q_f32(&result.m2, rows.val[2]);
+    vst1q_f32(&result.m3, rows.val[3]);
+#else
     result.m0 = mat.m0;
     result.m1 = mat.m4;
     result.m2 = mat.m8;
@@ -1190,6 +1232,7 @@ RMAPI Matrix MatrixTranspose(Matrix mat)
     result.m13 = mat.m7;
     result.m14 = mat.m11;
     result.m15 = mat.m15;
+#endif
 
     return result;
 }
@@ -1199,6 +1242,65 @@ RMAPI Matrix MatrixInvert(Matrix mat)
 {
     Matrix result = { 0 };
 
+    // NOTE: SSE2 only, NEON builds use the scalar inverse below
+#if defined(RAYMATH_SIMD_SSE)
+    // Blockwise inversion over the four 2x2 sub-matrices, each held in one register
+    // NOTE: Inverse of the transpose is the transpose of the inverse, so the struct rows are used as is
+    // Based on: https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+    #define RM_SHUFFLE(v1, v2, x, y, z, w) _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(w, z, y, x))
+    #define RM_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+    #define RM_MAT2_MUL(v1, v2) _mm_add_ps(_mm_mul_ps(v1, RM_SWIZZLE(v2, 0, 3, 0, 3)), _mm_mul_ps(RM_SWIZZLE(v1, 1, 0, 3, 2), RM_SWIZZLE(v2, 2, 1, 2, 1)))
+    #define RM_MAT2_ADJ_MUL(v1, v2) _mm_sub_ps(_mm_mul_ps(RM_SWIZZLE(v1, 3, 3, 0, 0), v2), _mm_mul_ps(RM_SWIZZLE(v1, 1, 1, 2, 2), RM_SWIZZLE(v2, 2, 3, 0, 1)))
+    #define RM_MAT2_MUL_ADJ(v1, v2) _mm_sub_ps(_mm_mul_ps(v1, RM_SWIZZLE(v2, 3, 0, 3, 0)), _mm_mul_ps(RM_SWIZZLE(v1, 1, 0, 3, 2), RM_SWIZZLE(v2, 2, 1, 2, 1)))
+
+    __m128 row0 = _mm_loadu_ps(&mat.m0);
+    __m128 row1 = _mm_loadu_ps(&mat.m1);
+    __m128 row2 = _mm_loadu_ps(&mat.m2);
+    __m128 row3 = _mm_loadu_ps(&mat.m3);
+
+    __m128 a = _mm_movelh_ps(row0, row1);
+    __m128 b = _mm_movehl_ps(row1, row0);
+    __m128 c = _mm_movelh_ps(row2, row3);
+    __m128 d = _mm_movehl_ps(row3, row2);
+
+    // Determinants of the four sub-matrices
+    __m128 detSub = _mm_sub_ps(_mm_mul_ps(RM_SHUFFLE(row0, row2, 0, 2, 0, 2), RM_SHUFFLE(row1, row3, 1, 3, 1, 3)),
+                               _mm_mul_ps(RM_SHUFFLE(row0, row2, 1, 3, 1, 3), RM_SHUFFLE(row1, row3, 0, 2, 0, 2)));
+    __m128 detA = RM_SWIZZLE(detSub, 0, 0, 0, 0);
+    __m128 detB = RM_SWIZZLE(detSub, 1, 1, 1, 1);
+    __m128 detC = RM_SWIZZLE(detSub, 2, 2, 2, 2);
+    __m128 detD = RM_SWIZZLE(detSub, 3, 3, 3, 3);
+
+    __m128 dc = RM_MAT2_ADJ_MUL(d, c);
+    __m128 ab = RM_MAT2_ADJ_MUL(a, b);
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), RM_MAT2_MUL(b, dc));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), RM_MAT2_MUL(c, ab));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), RM_MAT2_MUL_ADJ(d, ab));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), RM_MAT2_MUL_ADJ(a, dc));
+
+    __m128 det = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+    __m128 tr = _mm_mul_ps(ab, RM_SWIZZLE(dc, 0, 2, 1, 3));
+    tr = _mm_add_ps(tr, RM_SWIZZLE(tr, 2, 3, 0, 1));
+    tr = _mm_add_ps(tr, RM_SWIZZLE(tr, 1, 0, 3, 2));
+    det = _mm_sub_ps(det, tr);
+
+    __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+    x = _mm_mul_ps(x, invDet);
+    y = _mm_mul_ps(y, invDet);
+    z = _mm_mul_ps(z, invDet);
+    w = _mm_mul_ps(w, invDet);
+
+    _mm_storeu_ps(&result.m0, RM_SHUFFLE(x, y, 3, 1, 3, 1));
+    _mm_storeu_ps(&result.m1, RM_SHUFFLE(x, y, 2, 0, 2, 0));
+    _mm_storeu_ps(&result.m2, RM_SHUFFLE(z, w, 3, 1, 3, 1));
+    _mm_storeu_ps(&result.m3, RM_SHUFFLE(z, w, 2, 0, 2, 0));
+
+    #undef RM_SHUFFLE
+    #undef RM_SWIZZLE
+    #undef RM_MAT2_MUL
+    #undef RM_MAT2_ADJ_MUL
+    #undef RM_MAT2_MUL_ADJ
+#else
     // Cache the matrix values (speed optimization)
     float a00 = mat.m0, a01 = mat.m1, a02 = mat.m2, a03 = mat.m3;
     float a10 = mat.m4, a11 = mat.m5, a12 = mat.m6, a13 = mat.m7;
@@ -1237,6 +1339,7 @@ RMAPI Matrix MatrixInvert(Matrix mat)
     result.m13 = (a00*b09 - a01*b07 + a02*b06)*invDet;
     result.m14 = (-a30*b03 + a31*b01 - a32*b00)*invDet;
     result.m15 = (a20*b03 - a21*b01 + a22*b00)*invDet;
+#endif
 
     return result;
 }
@@ -220,6 +220,9 @@ __declspec(dllimport) int __stdcall WideCharToMultiByte(unsigned int cp, unsigne
 #ifndef MAX_CHAR_PRESSED_QUEUE
     #define MAX_CHAR_PRESSED_QUEUE        16        // Maximum number of characters in the char input queue
 #endif
+#ifndef MAX_MOUSE_SAMPLE_QUEUE
+    #define MAX_MOUSE_SAMPLE_QUEUE       256        // Maximum number of cursor samples registered between input polls
+#endif
 
 #ifndef MAX_DECOMPRESSION_SIZE
     #define MAX_DECOMPRESSION_SIZE        64        // Maximum size allocated for decompression in MB
@@ -309,6 +312,9 @@ typedef struct CoreData {
             Vector2 currentWheelMove;       // Registers current mouse wheel variation
             Vector2 previousWheelMove;      // Registers previous mouse wheel variation
 
+            MouseSample sampleQueue[MAX_MOUSE_SAMPLE_QUEUE]; // Cursor samples registered since last poll
+            int sampleQueueCount;           // Cursor samples queue count
+
         } Mouse;
         struct {
             int pointCount;                             // Number of touch points active
@@ -456,6 +462,9 @@ static bool automationEventRecording = false;               // Recording automat
 extern void LoadFontDefault(void);      // [Module: text] Loads default font on InitWindow()
 extern void UnloadFontDefault(void);    // [Module: text] Unloads default font from GPU memory
 #endif
+#if defined(SUPPORT_MODULE_RMODELS)
+extern void UnloadGeometryTemplates(void);  // [Module: models] Unloads shapes geometry templates cache
+#endif
 
 extern int InitPlatform(void);          // Initialize platform (graphics, inputs and more)
 extern void ClosePlatform(void);        // Close platform
@@ -680,6 +689,10 @@ void CloseWindow(void)
     UnloadFontDefault();        // WARNING: Module required: rtext
 #endif
 
+#if defined(SUPPORT_MODULE_RMODELS)
+    UnloadGeometryTemplates();  // WARNING: Module required: rmodels
+#endif
+
     rlglClose();                // De-init rlgl
 
     // De-initialize platform
@@ -1395,58 +1408,97 @@ void SetShaderValueTexture(Shader shader, int locIndex, Texture2D texture)
 // Get a ray trace from mouse position
 Ray GetMouseRay(Vector2 mouse, Camera camera)
 {
-    Ray ray = { 0 };
+    CameraRayState state = GetCameraRayState(camera, GetScreenWidth(), GetScreenHeight());
 
-    // Calculate normalized device coordinates
-    // NOTE: y value is negative
-    float x = (2.0f*mouse.x)/(float)GetScreenWidth() - 1.0f;
-    float y = 1.0f - (2.0f*mouse.y)/(float)GetScreenHeight();
-    float z = 1.0f;
+    return GetCameraRay(state, mouse);
+}
 
-    // Store values in a vector
-    Vector3 deviceCoords = { x, y, z };
+// Get camera state for ray queries
+// NOTE: Instead of inverting the view-projection matrix and unprojecting points through it,
+// the inverse is kept as the camera basis scaled by the projection extents, so every ray
+// afterwards only costs a few multiply-adds (and a normalization for perspective)
+CameraRayState GetCameraRayState(Camera camera, int width, int height)
+{
+    CameraRayState state = { 0 };
 
-    // Calculate view matrix from camera look at
-    Matrix matView = MatrixLookAt(camera.position, camera.target, camera.up);
+    // Same basis MatrixLookAt() builds the view matrix from
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+    Vector3 up = Vector3CrossProduct(right, forward);
 
-    Matrix matProj = MatrixIdentity();
+    double aspect = (double)width/(double)height;
+    double top = 0.0;
 
     if (camera.projection == CAMERA_PERSPECTIVE)
     {
-        // Calculate projection matrix from perspective
-        matProj = MatrixPerspective(camera.fovy*DEG2RAD, ((double)GetScreenWidth()/(double)GetScreenHeight()), RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+        // Half height of the view at distance 1, like MatrixPerspective()
+        top = tan(camera.fovy*0.5*DEG2RAD);
+        state.position = camera.position;
     }
     else if (camera.projection == CAMERA_ORTHOGRAPHIC)
     {
-        double aspect = (double)CORE.Window.screen.width/(double)CORE.Window.screen.height;
-        double top = camera.fovy/2.0;
-        double right = top*aspect;
-
-        // Calculate projection matrix from orthographic
-        matProj = MatrixOrtho(-right, right, -top, top, 0.01, 1000.0);
+        // Half height of the view volume, rays start at the near plane
+        top = camera.fovy/2.0;
+        state.position = Vector3Add(camera.position, Vector3Scale(forward, 0.01f));
     }
 
-    // Unproject far/near points
-    Vector3 nearPoint = Vector3Unproject((Vector3){ deviceCoords.x, deviceCoords.y, 0.0f }, matProj, matView);
-    Vector3 farPoint = Vector3Unproject((Vector3){ deviceCoords.x, deviceCoords.y, 1.0f }, matProj, matView);
+    state.forward = forward;
+    state.right = Vector3Scale(right, (float)(top*aspect));
+    state.up = Vector3Scale(up, (float)top);
+    state.width = (float)width;
+    state.height = (float)height;
+    state.projection = camera.projection;
 
-    // Unproject the mouse cursor in the near plane.
-    // We need this as the source position because orthographic projects, compared to perspective doesn't have a
-    // convergence point, meaning that the "eye" of the camera is more like a plane than a point.
-    Vector3 cameraPlanePointerPos = Vector3Unproject((Vector3){ deviceCoords.x, deviceCoords.y, -1.0f }, matProj, matView);
+    return state;
+}
+
+// Get a ray trace from screen position using camera state
+// NOTE: Screen center returns the camera forward direction directly
+Ray GetCameraRay(CameraRayState state, Vector2 position)
+{
+    Ray ray = { 0 };
 
-    // Calculate normalized direction vector
-    Vector3 direction = Vector3Normalize(Vector3Subtract(farPoint, nearPoint));
+    // Calculate normalized device coordinates
+    // NOTE: y value is negative
+    float x = (2.0f*position.x)/state.width - 1.0f;
+    float y = 1.0f - (2.0f*position.y)/state.height;
 
-    if (camera.projection == CAMERA_PERSPECTIVE) ray.position = camera.position;
-    else if (camera.projection == CAMERA_ORTHOGRAPHIC) ray.position = cameraPlanePointerPos;
+    if ((x == 0.0f) && (y == 0.0f))
+    {
+        ray.position = state.position;
+        ray.direction = state.forward;
+    }
+    else if (state.projection == CAMERA_PERSPECTIVE)
+    {
+        Vector3 direction = {
+            state.forward.x + state.right.x*x + state.up.x*y,
+            state.forward.y + state.right.y*x + state.up.y*y,
+            state.forward.z + state.right.z*x + state.up.z*y
+        };
 
-    // Apply calculated vectors to ray
-    ray.direction = direction;
+        ray.position = state.position;
+        ray.direction = Vector3Normalize(direction);
+    }
+    else if (state.projection == CAMERA_ORTHOGRAPHIC)
+    {
+        // Orthographic rays are parallel, the screen position moves the origin instead
+        ray.position = (Vector3){
+            state.position.x + state.right.x*x + state.up.x*y,
+            state.position.y + state.right.y*x + state.up.y*y,
+            state.position.z + state.right.z*x + state.up.z*y
+        };
+        ray.direction = state.forward;
+    }
 
     return ray;
 }
 
+// Get ray traces from multiple screen positions using camera state
+void GetCameraRays(CameraRayState state, const Vector2 *positions, Ray *rays, int count)
+{
+    for (int i = 0; i < count; i++) rays[i] = GetCameraRay(state, positions[i]);
+}
+
 // Get transform matrix for camera
 Matrix GetCameraMatrix(Camera camera)
 {
@@ -2949,6 +3001,30 @@ Vector2 GetMouseDelta(void)
     return delta;
 }
 
+// Get number of cursor samples registered in the last input poll
+// NOTE: Only platforms that report cursor movement through callbacks register samples,
+// on the rest of platforms this returns 0 and GetMousePosition() should be used
+int GetMouseSampleCount(void)
+{
+    return CORE.Input.Mouse.sampleQueueCount;
+}
+
+// Get cursor sample registered in the last input poll
+// NOTE: Samples are ordered oldest first, position has mouse offset and scale applied
+MouseSample GetMouseSample(int index)
+{
+    MouseSample sample = { 0 };
+
+    if ((index >= 0) && (index < CORE.Input.Mouse.sampleQueueCount))
+    {
+        sample = CORE.Input.Mouse.sampleQueue[index];
+        sample.position.x = (sample.position.x + CORE.Input.Mouse.offset.x)*CORE.Input.Mouse.scale.x;
+        sample.position.y = (sample.position.y + CORE.Input.Mouse.offset.y)*CORE.Input.Mouse.scale.y;
+    }
+
+    return sample;
+}
+
 // Set mouse offset
 // NOTE: Useful when rendering to different size targets
 void SetMouseOffset(int offsetX, int offsetY)
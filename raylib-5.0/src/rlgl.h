@@ -51,11 +51,16 @@
 *
 *       #define RL_DEFAULT_BATCH_BUFFER_ELEMENTS   8192    // Default internal render batch elements limits
 *       #define RL_DEFAULT_BATCH_BUFFERS              1    // Default number of batch buffers (multi-buffering)
+*
+*       NOTE: With more than one batch buffer on OpenGL 3.3+, buffers are fenced and, if GL_ARB_buffer_storage
+*       is available, persistently mapped so uploads never write a buffer the GPU is still reading,
+*       rlGetRenderBatchStalls() reports how many uploads found the GPU behind
 *       #define RL_DEFAULT_BATCH_DRAWCALLS          256    // Default number of batch draw calls (by state changes: mode, texture)
 *       #define RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS    4    // Maximum number of textures units that can be activated on batch drawing (SetShaderValueTexture())
 *
 *       #define RL_MAX_MATRIX_STACK_SIZE             32    // Maximum size of internal Matrix stack
 *       #define RL_MAX_SHADER_LOCATIONS              32    // Maximum number of shader locations supported
+*       #define RL_MAX_TEXTURE_ALIASES               16    // Maximum number of textures aliased to an atlas region
 *       #define RL_CULL_DISTANCE_NEAR              0.01    // Default projection matrix near cull distance
 *       #define RL_CULL_DISTANCE_FAR             1000.0    // Default projection matrix far cull distance
 *
@@ -228,6 +233,11 @@
     #define RL_MAX_SHADER_LOCATIONS                 32      // Maximum number of shader locations supported
 #endif
 
+// Texture aliases
+#ifndef RL_MAX_TEXTURE_ALIASES
+    #define RL_MAX_TEXTURE_ALIASES                  16      // Maximum number of textures aliased to an atlas region
+#endif
+
 // Projection matrix culling
 #ifndef RL_CULL_DISTANCE_NEAR
     #define RL_CULL_DISTANCE_NEAR                 0.01      // Default near cull distance
@@ -355,6 +365,9 @@ typedef struct rlVertexBuffer {
 #endif
     unsigned int vaoId;         // OpenGL Vertex Array Object id
     unsigned int vboId[4];      // OpenGL Vertex Buffer Objects id (4 types of vertex data)
+    void *mapped[3];            // Persistent mapped VBO memory for vertices, texcoords and colors (all three or none, NULL if not mapped)
+    void *fence;                // OpenGL sync object of the last draw reading the buffer (GLsync, NULL if none)
+    unsigned char *packed;      // Interleaved vertex data packed for upload (compact vertex formats not persistent mapped, NULL otherwise)
 } rlVertexBuffer;
 
 // Draw call type
@@ -368,6 +381,7 @@ typedef struct rlDrawCall {
     //unsigned int vaoId;       // Vertex array id to be used on the draw -> Using RLGL.currentBatch->vertexBuffer.vaoId
     //unsigned int shaderId;    // Shader id to be used on the draw -> Using RLGL.currentShaderId
     unsigned int textureId;     // Texture id to be used on the draw -> Use to create new draw call if changes
+    int layer;                  // Draw layer, deferred draws are sorted by layer, texture and mode on batch draw
 
     //Matrix projection;        // Projection matrix for this draw -> Using RLGL.projection by default
     //Matrix modelview;         // Modelview matrix for this draw -> Using RLGL.modelview by default
@@ -382,8 +396,19 @@ typedef struct rlRenderBatch {
     rlDrawCall *draws;          // Draw calls array, depends on textureId
     int drawCounter;            // Draw calls counter
     float currentDepth;         // Current depth value for next draw
+    int vertexFormat;           // Vertex format uploaded to GPU (rlBatchVertexFormat)
 } rlRenderBatch;
 
+// rlVertexSpan type, vertices reserved in the current draw for bulk submission
+// NOTE: Arrays point directly into the render batch vertex buffer (OpenGL 3.3+, ES2)
+typedef struct rlVertexSpan {
+    float *vertices;            // Vertex position (XYZ - 3 components per vertex), untransformed
+    float *texcoords;           // Vertex texture coordinates (UV - 2 components per vertex)
+    unsigned char *colors;      // Vertex colors (RGBA - 4 components per vertex)
+    int count;                  // Number of vertices reserved, 0 if the request did not fit
+    float depth;                // Depth value for 2d vertices of the current draw (Z)
+} rlVertexSpan;
+
 // OpenGL version
 typedef enum {
     RL_OPENGL_11 = 1,           // OpenGL 1.1
@@ -547,6 +572,15 @@ typedef enum {
     RL_CULL_FACE_BACK
 } rlCullMode;
 
+// Render batch vertex formats, as uploaded to GPU
+// NOTE: Compact formats pack texcoords as normalized shorts, so they must stay in [0..1] (no texture
+// wrapping), 2d format drops position Z so it requires depth test disabled (2d drawing)
+typedef enum {
+    RL_BATCH_VERTEX_SEPARATE = 0,       // Separate buffers: float3 position, float2 texcoord, ubyte4 color (24 bytes)
+    RL_BATCH_VERTEX_COMPACT,            // Interleaved: float3 position, ushort2 texcoord, ubyte4 color (20 bytes)
+    RL_BATCH_VERTEX_COMPACT_2D          // Interleaved: float2 position, ushort2 texcoord, ubyte4 color (16 bytes)
+} rlBatchVertexFormat;
+
 //------------------------------------------------------------------------------------
 // Functions Declaration - Matrix operations
 //------------------------------------------------------------------------------------
@@ -580,6 +614,8 @@ RLAPI void rlNormal3f(float x, float y, float z);     // Define one vertex (norm
 RLAPI void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a);  // Define one vertex (color) - 4 byte
 RLAPI void rlColor3f(float x, float y, float z);          // Define one vertex (color) - 3 float
 RLAPI void rlColor4f(float x, float y, float z, float w); // Define one vertex (color) - 4 float
+RLAPI rlVertexSpan rlReserveVertices(int count);      // Reserve vertices for current draw mode, all attributes must be written by caller
+RLAPI void rlCommitVertices(rlVertexSpan span);       // Submit reserved vertices, applying current transform if required
 
 //------------------------------------------------------------------------------------
 // Functions Declaration - OpenGL style functions (common to 1.1, 3.3+, ES2)
@@ -672,13 +708,20 @@ RLAPI int *rlGetShaderLocsDefault(void);                // Get default shader lo
 // NOTE: rlgl provides a default render batch to behave like OpenGL 1.1 immediate mode
 // but this render batch API is exposed in case of custom batches are required
 RLAPI rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements);  // Load a render batch system
+RLAPI rlRenderBatch rlLoadRenderBatchFormat(int numBuffers, int bufferElements, int vertexFormat);  // Load a render batch system with a vertex format (rlBatchVertexFormat)
 RLAPI void rlUnloadRenderBatch(rlRenderBatch batch);                        // Unload render batch system
 RLAPI void rlDrawRenderBatch(rlRenderBatch *batch);                         // Draw render batch data (Update->Draw->Reset)
 RLAPI void rlSetRenderBatchActive(rlRenderBatch *batch);                    // Set the active render batch for rlgl (NULL for default internal)
 RLAPI void rlDrawRenderBatchActive(void);                                   // Update and draw internal render batch
 RLAPI bool rlCheckRenderBatchLimit(int vCount);                             // Check internal buffer overflow for a given number of vertex
+RLAPI unsigned int rlGetRenderBatchStalls(void);                            // Get number of batch uploads that found the GPU still reading the buffer
 
 RLAPI void rlSetTexture(unsigned int id);               // Set current texture for render batch and check buffers limits
+RLAPI void rlEnableDeferredDraws(void);                 // Enable deferred draws, batch draws are sorted by layer, texture and mode on submission
+RLAPI void rlDisableDeferredDraws(void);                // Disable deferred draws, batch draws are submitted in order
+RLAPI void rlSetDrawLayer(int layer);                   // Set current draw layer, lower layers are drawn first when deferred
+RLAPI void rlGetDrawCallCounters(int *recorded, int *submitted);  // Get batch draw calls recorded and submitted since last call
+RLAPI void rlSetTextureAlias(unsigned int id, unsigned int atlasId, float x, float y, float width, float height); // Set texture drawn from an atlas region (normalized), atlasId 0 removes it
 
 //------------------------------------------------------------------------------------------------------------------------
 
@@ -962,6 +1005,14 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+// Texture alias, batch draws of the texture are drawn from an atlas region
+typedef struct rlTextureAlias {
+    unsigned int id;                        // Texture id aliased
+    unsigned int atlasId;                   // Atlas texture id drawn instead
+    float x, y;                             // Region position on atlas (normalized)
+    float width, height;                    // Region size on atlas (normalized)
+} rlTextureAlias;
+
 typedef struct rlglData {
     rlRenderBatch *currentBatch;            // Current render batch
     rlRenderBatch defaultBatch;             // Default internal render batch
@@ -980,6 +1031,19 @@ typedef struct rlglData {
         bool transformRequired;             // Require transform matrix application to current draw-call vertex (if required)
         Matrix stack[RL_MAX_MATRIX_STACK_SIZE];// Matrix stack for push/pop
         int stackCounter;                   // Matrix stack counter
+        unsigned int batchStalls;           // Render batch uploads that found the GPU still reading the buffer
+
+        bool deferredDraws;                 // Sort batch draws by layer, texture and mode on submission
+        int drawLayer;                      // Current draw layer, recorded on new draws
+        int drawCallsRecorded;              // Batch draws recorded since last rlGetDrawCallCounters()
+        int drawCallsSubmitted;             // Batch draws submitted since last rlGetDrawCallCounters()
+        float *sortVertices;                // Deferred draws sorting buffer: vertex positions
+        float *sortTexcoords;               // Deferred draws sorting buffer: vertex texcoords
+        unsigned char *sortColors;          // Deferred draws sorting buffer: vertex colors
+        int sortCapacity;                   // Deferred draws sorting buffer vertex capacity
+
+        rlTextureAlias textureAliases[RL_MAX_TEXTURE_ALIASES];  // Textures drawn from an atlas region
+        int textureAliasCount;              // Number of texture aliases set
 
         unsigned int defaultTextureId;      // Default texture used on shapes/poly drawing (required by shader)
         unsigned int activeTextureId[RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS];    // Active texture ids to be enabled on batch drawing (0 active by default)
@@ -1028,6 +1092,8 @@ typedef struct rlglData {
         bool texAnisoFilter;                // Anisotropic texture filtering support (GL_EXT_texture_filter_anisotropic)
         bool computeShader;                 // Compute shaders support (GL_ARB_compute_shader)
         bool ssbo;                          // Shader storage buffer object support (GL_ARB_shader_storage_buffer_object)
+        bool sync;                          // Sync objects support (GL_ARB_sync, core on OpenGL 3.2)
+        bool bufferStorage;                 // Immutable buffer storage, persistent mapping support (GL_ARB_buffer_storage)
 
         float maxAnisotropyLevel;           // Maximum anisotropy level supported (minimum is 2.0f)
         int maxDepthBits;                   // Maximum bits for depth component
@@ -1046,6 +1112,11 @@ typedef void *(*rlglLoadProc)(const char *name);   // OpenGL extension functions
 static rlglData RLGL = { 0 };
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
 
+#if defined(GRAPHICS_API_OPENGL_11)
+static rlVertexSpan spanScratch = { 0 };    // Reserved vertices storage, submitted as immediate calls
+static int spanScratchCapacity = 0;         // Number of vertices spanScratch can store
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_ES2) && !defined(GRAPHICS_API_OPENGL_ES3)
 // NOTE: VAO functionality is exposed through extensions (OES)
 static PFNGLGENVERTEXARRAYSOESPROC glGenVertexArrays = NULL;
@@ -1064,6 +1135,12 @@ static PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisor = NULL;
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 static void rlLoadShaderDefault(void);      // Load default shader
 static void rlUnloadShaderDefault(void);    // Unload default shader
+static void *rlLoadPersistentBuffer(int size, const void *data);    // Load persistent mapped storage for bound array buffer
+static void rlSortRenderBatch(rlRenderBatch *batch);                // Sort batch draws by layer, texture and mode, merging equal ones
+static void rlResolveTextureAliases(rlRenderBatch *batch);          // Redirect batch draws of aliased textures to their atlas, merging adjacent ones
+static int rlGetBatchVertexStride(int vertexFormat);                // Get batch vertex size in bytes for a compact vertex format
+static void rlSetBatchCompactAttribs(unsigned int vboId, int vertexFormat);     // Set batch vertex attributes for a compact vertex format
+static void rlPackBatchVertices(const rlVertexBuffer *buffer, int vertexFormat, int count, unsigned char *packed);  // Pack batch vertices for a compact vertex format
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 static const char *rlGetCompressedFormatName(int format); // Get compressed format official GL identifier name
 #endif  // RLGL_SHOW_GL_DETAILS_INFO
@@ -1342,6 +1419,34 @@ void rlNormal3f(float x, float y, float z) { glNormal3f(x, y, z); }
 void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a) { glColor4ub(r, g, b, a); }
 void rlColor3f(float x, float y, float z) { glColor3f(x, y, z); }
 void rlColor4f(float x, float y, float z, float w) { glColor4f(x, y, z, w); }
+
+// Reserve vertices on a scratch buffer, they are submitted on rlCommitVertices()
+rlVertexSpan rlReserveVertices(int count)
+{
+    if (count > spanScratchCapacity)
+    {
+        spanScratch.vertices = (float *)RL_REALLOC(spanScratch.vertices, count*3*sizeof(float));
+        spanScratch.texcoords = (float *)RL_REALLOC(spanScratch.texcoords, count*2*sizeof(float));
+        spanScratch.colors = (unsigned char *)RL_REALLOC(spanScratch.colors, count*4*sizeof(unsigned char));
+        spanScratchCapacity = count;
+    }
+
+    rlVertexSpan span = spanScratch;
+    span.count = count;
+    span.depth = 0.0f;
+
+    return span;
+}
+
+void rlCommitVertices(rlVertexSpan span)
+{
+    for (int i = 0; i < span.count; i++)
+    {
+        glTexCoord2f(span.texcoords[2*i], span.texcoords[2*i + 1]);
+        glColor4ub(span.colors[4*i], span.colors[4*i + 1], span.colors[4*i + 2], span.colors[4*i + 3]);
+        glVertex3f(span.vertices[3*i], span.vertices[3*i + 1], span.vertices[3*i + 2]);
+    }
+}
 #endif
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 // Initialize drawing mode (how to organize vertex)
@@ -1374,6 +1479,7 @@ void rlBegin(int mode)
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode = mode;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = RLGL.State.defaultTextureId;
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].layer = RLGL.State.drawLayer;
     }
 }
 
@@ -1498,6 +1604,58 @@ void rlColor3f(float x, float y, float z)
     rlColor4ub((unsigned char)(x*255), (unsigned char)(y*255), (unsigned char)(z*255), 255);
 }
 
+// Reserve vertices for the current draw mode (set by rlBegin())
+// NOTE: Positions, texcoords and colors of every reserved vertex must be written by the caller
+// before calling rlCommitVertices(), no other vertex level function can be called in between.
+// Count must be a whole number of primitives (2 for RL_LINES, 3 for RL_TRIANGLES, 4 for RL_QUADS),
+// they are never split across batches, if the batch is full it is drawn first
+rlVertexSpan rlReserveVertices(int count)
+{
+    rlVertexSpan span = { 0 };
+
+    if (count >= RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4)
+    {
+        TRACELOG(RL_LOG_WARNING, "RLGL: Requested vertices do not fit in render batch (%i)", count);
+        return span;
+    }
+
+    rlCheckRenderBatchLimit(count);
+
+    // NOTE: Current buffer could have changed on batch draw (multi-buffering)
+    rlVertexBuffer *buffer = &RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer];
+
+    span.vertices = buffer->vertices + 3*RLGL.State.vertexCounter;
+    span.texcoords = buffer->texcoords + 2*RLGL.State.vertexCounter;
+    span.colors = buffer->colors + 4*RLGL.State.vertexCounter;
+    span.count = count;
+    span.depth = RLGL.currentBatch->currentDepth;
+
+    RLGL.State.vertexCounter += count;
+    RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount += count;
+
+    return span;
+}
+
+// Submit vertices reserved with rlReserveVertices()
+// NOTE: Vertex data is already in place, only the current transform has to be applied
+void rlCommitVertices(rlVertexSpan span)
+{
+    if (RLGL.State.transformRequired)
+    {
+        Matrix mat = RLGL.State.transform;
+
+        for (int i = 0; i < span.count; i++)
+        {
+            float *v = span.vertices + 3*i;
+            float x = v[0], y = v[1], z = v[2];
+
+            v[0] = mat.m0*x + mat.m4*y + mat.m8*z + mat.m12;
+            v[1] = mat.m1*x + mat.m5*y + mat.m9*z + mat.m13;
+            v[2] = mat.m2*x + mat.m6*y + mat.m10*z + mat.m14;
+        }
+    }
+}
+
 #endif
 
 //--------------------------------------------------------------------------------------
@@ -1550,11 +1708,124 @@ void rlSetTexture(unsigned int id)
 
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = id;
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
+            RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].layer = RLGL.State.drawLayer;
         }
 #endif
     }
 }
 
+// Enable deferred draws
+// NOTE: Draws sharing a layer are reordered by texture and mode to merge them, so they must not
+// depend on submission order (opaque geometry, non-overlapping 2d); overlapping blended draws
+// should use increasing layers. Current batch is drawn first, only following draws are deferred
+void rlEnableDeferredDraws(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!RLGL.State.deferredDraws)
+    {
+        rlDrawRenderBatch(RLGL.currentBatch);
+        RLGL.State.deferredDraws = true;
+    }
+#endif
+}
+
+// Disable deferred draws
+// NOTE: Deferred draws recorded are sorted and drawn
+void rlDisableDeferredDraws(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (RLGL.State.deferredDraws)
+    {
+        rlDrawRenderBatch(RLGL.currentBatch);
+        RLGL.State.deferredDraws = false;
+        RLGL.State.drawLayer = 0;
+    }
+#endif
+}
+
+// Set current draw layer
+// NOTE: Layer is only considered with deferred draws enabled
+void rlSetDrawLayer(int layer)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (RLGL.State.drawLayer == layer) return;
+
+    RLGL.State.drawLayer = layer;
+
+    if (RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount > 0)
+    {
+        // Start a new draw with current mode and texture, aligned as on texture change
+        int mode = RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode;
+        unsigned int textureId = RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId;
+
+        if (mode == RL_LINES) RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexAlignment = ((RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount < 4)? RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount : RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount%4);
+        else if (mode == RL_TRIANGLES) RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexAlignment = ((RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount < 4)? 1 : (4 - (RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount%4)));
+        else RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexAlignment = 0;
+
+        if (!rlCheckRenderBatchLimit(RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexAlignment))
+        {
+            RLGL.State.vertexCounter += RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexAlignment;
+
+            RLGL.currentBatch->drawCounter++;
+        }
+
+        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode = mode;
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = textureId;
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
+    }
+
+    RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].layer = layer;
+#endif
+}
+
+// Get batch draw calls recorded and submitted since last call
+// NOTE: Deferred draws sharing layer, texture and mode are submitted as one
+void rlGetDrawCallCounters(int *recorded, int *submitted)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (recorded != NULL) *recorded = RLGL.State.drawCallsRecorded;
+    if (submitted != NULL) *submitted = RLGL.State.drawCallsSubmitted;
+
+    RLGL.State.drawCallsRecorded = 0;
+    RLGL.State.drawCallsSubmitted = 0;
+#else
+    if (recorded != NULL) *recorded = 0;
+    if (submitted != NULL) *submitted = 0;
+#endif
+}
+
+// Set texture drawn from an atlas region
+// NOTE: Batch draws of the texture get their texcoords mapped to the region and use the atlas, so
+// draws of textures sharing an atlas merge into one draw call. Texcoords must stay within [0..1]
+// (no wrapping) and regions should be padded to avoid filtering bleed. Resolved on batch draw
+void rlSetTextureAlias(unsigned int id, unsigned int atlasId, float x, float y, float width, float height)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    // Draws already recorded keep the previous alias
+    rlDrawRenderBatch(RLGL.currentBatch);
+
+    int index = 0;
+    while ((index < RLGL.State.textureAliasCount) && (RLGL.State.textureAliases[index].id != id)) index++;
+
+    if (atlasId == 0)
+    {
+        if (index < RLGL.State.textureAliasCount) RLGL.State.textureAliases[index] = RLGL.State.textureAliases[--RLGL.State.textureAliasCount];
+        return;
+    }
+
+    if (index == RL_MAX_TEXTURE_ALIASES)
+    {
+        TRACELOG(RL_LOG_WARNING, "TEXTURE: [ID %i] Failed to alias texture, limit reached (RL_MAX_TEXTURE_ALIASES)", id);
+        return;
+    }
+
+    RLGL.State.textureAliases[index] = (rlTextureAlias){ id, atlasId, x, y, width, height };
+    if (index == RLGL.State.textureAliasCount) RLGL.State.textureAliasCount++;
+#endif
+}
+
 // Select and active a texture slot
 void rlActiveTextureSlot(int slot)
 {
@@ -2185,9 +2456,22 @@ void rlglClose(void)
 
     rlUnloadShaderDefault();          // Unload default shader
 
+    RL_FREE(RLGL.State.sortVertices);
+    RL_FREE(RLGL.State.sortTexcoords);
+    RL_FREE(RLGL.State.sortColors);
+    RLGL.State.sortCapacity = 0;
+    RLGL.State.textureAliasCount = 0;
+
     glDeleteTextures(1, &RLGL.State.defaultTextureId); // Unload default texture
     TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Default texture unloaded successfully", RLGL.State.defaultTextureId);
 #endif
+#if defined(GRAPHICS_API_OPENGL_11)
+    RL_FREE(spanScratch.vertices);
+    RL_FREE(spanScratch.texcoords);
+    RL_FREE(spanScratch.colors);
+    spanScratch = (rlVertexSpan){ 0 };
+    spanScratchCapacity = 0;
+#endif
 }
 
 // Load OpenGL extensions
@@ -2241,6 +2525,8 @@ void rlLoadExtensions(void *loader)
     RLGL.ExtSupported.texCompASTC = GLAD_GL_KHR_texture_compression_astc_hdr && GLAD_GL_KHR_texture_compression_astc_ldr;
     RLGL.ExtSupported.texCompDXT = GLAD_GL_EXT_texture_compression_s3tc;  // Texture compression: DXT
     RLGL.ExtSupported.texCompETC2 = GLAD_GL_ARB_ES3_compatibility;        // Texture compression: ETC2/EAC
+    RLGL.ExtSupported.sync = GLAD_GL_VERSION_3_2;                         // Sync objects, render batch fences
+    RLGL.ExtSupported.bufferStorage = GLAD_GL_ARB_buffer_storage;         // Persistent mapped render batch buffers
     #if defined(GRAPHICS_API_OPENGL_43)
     RLGL.ExtSupported.computeShader = GLAD_GL_ARB_compute_shader;
     RLGL.ExtSupported.ssbo = GLAD_GL_ARB_shader_storage_buffer_object;
@@ -2553,6 +2839,13 @@ int *rlGetShaderLocsDefault(void)
 //------------------------------------------------------------------------------------------------
 // Load render batch
 rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
+{
+    return rlLoadRenderBatchFormat(numBuffers, bufferElements, RL_BATCH_VERTEX_SEPARATE);
+}
+
+// Load render batch with a vertex format
+// NOTE: Vertex data is kept in separate arrays on CPU, compact formats are packed on upload
+rlRenderBatch rlLoadRenderBatchFormat(int numBuffers, int bufferElements, int vertexFormat)
 {
     rlRenderBatch batch = { 0 };
 
@@ -2601,9 +2894,21 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
     //--------------------------------------------------------------------------------------------
 
     // Upload to GPU (VRAM) vertex data and initialize VAOs/VBOs
+    // NOTE: Persistent mapping requires multi-buffering, with a single buffer
+    // every upload would wait for the previous draw to finish
     //--------------------------------------------------------------------------------------------
+    bool persistent = false;
+#if defined(GRAPHICS_API_OPENGL_33)
+    persistent = RLGL.ExtSupported.bufferStorage && RLGL.ExtSupported.sync && (numBuffers > 1);
+#endif
+
     for (int i = 0; i < numBuffers; i++)
     {
+        batch.vertexBuffer[i].mapped[0] = NULL;
+        batch.vertexBuffer[i].mapped[1] = NULL;
+        batch.vertexBuffer[i].mapped[2] = NULL;
+        batch.vertexBuffer[i].fence = NULL;
+
         if (RLGL.ExtSupported.vao)
         {
             // Initialize Quads VAO
@@ -2611,27 +2916,64 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
             glBindVertexArray(batch.vertexBuffer[i].vaoId);
         }
 
-        // Quads - Vertex buffers binding and attributes enable
-        // Vertex position buffer (shader-location = 0)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].vertices, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
-        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-
-        // Vertex texcoord buffer (shader-location = 1)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[1]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[1]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*2*4*sizeof(float), batch.vertexBuffer[i].texcoords, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
-        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
-
-        // Vertex color buffer (shader-location = 3)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[2]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[2]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*4*4*sizeof(unsigned char), batch.vertexBuffer[i].colors, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
-        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+        batch.vertexBuffer[i].packed = NULL;
+
+        if (vertexFormat == RL_BATCH_VERTEX_SEPARATE)
+        {
+            // Quads - Vertex buffers binding and attributes enable
+            // Vertex position buffer (shader-location = 0)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
+            if (persistent) batch.vertexBuffer[i].mapped[0] = rlLoadPersistentBuffer(bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].vertices);
+            else glBufferData(GL_ARRAY_BUFFER, bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].vertices, GL_DYNAMIC_DRAW);
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
+
+            // Vertex texcoord buffer (shader-location = 1)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[1]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[1]);
+            if (persistent) batch.vertexBuffer[i].mapped[1] = rlLoadPersistentBuffer(bufferElements*2*4*sizeof(float), batch.vertexBuffer[i].texcoords);
+            else glBufferData(GL_ARRAY_BUFFER, bufferElements*2*4*sizeof(float), batch.vertexBuffer[i].texcoords, GL_DYNAMIC_DRAW);
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
+
+            // Vertex color buffer (shader-location = 3)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[2]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[2]);
+            if (persistent) batch.vertexBuffer[i].mapped[2] = rlLoadPersistentBuffer(bufferElements*4*4*sizeof(unsigned char), batch.vertexBuffer[i].colors);
+            else glBufferData(GL_ARRAY_BUFFER, bufferElements*4*4*sizeof(unsigned char), batch.vertexBuffer[i].colors, GL_DYNAMIC_DRAW);
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+
+#if defined(GRAPHICS_API_OPENGL_33)
+            // Either all three buffers are mapped or none, if any mapping failed the others are
+            // unmapped and the buffer is uploaded with glBufferSubData() (storage is dynamic)
+            if (persistent && ((batch.vertexBuffer[i].mapped[0] == NULL) || (batch.vertexBuffer[i].mapped[1] == NULL) || (batch.vertexBuffer[i].mapped[2] == NULL)))
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    if (batch.vertexBuffer[i].mapped[k] != NULL)
+                    {
+                        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[k]);
+                        glUnmapBuffer(GL_ARRAY_BUFFER);
+                        batch.vertexBuffer[i].mapped[k] = NULL;
+                    }
+                }
+            }
+#endif
+        }
+        else
+        {
+            // Interleaved vertex buffer, packed on upload
+            int stride = rlGetBatchVertexStride(vertexFormat);
+
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
+            if (persistent) batch.vertexBuffer[i].mapped[0] = rlLoadPersistentBuffer(bufferElements*4*stride, NULL);
+            else glBufferData(GL_ARRAY_BUFFER, bufferElements*4*stride, NULL, GL_DYNAMIC_DRAW);
+            if (batch.vertexBuffer[i].mapped[0] == NULL) batch.vertexBuffer[i].packed = (unsigned char *)RL_MALLOC(bufferElements*4*stride);
+            rlSetBatchCompactAttribs(batch.vertexBuffer[i].vboId[0], vertexFormat);
+        }
 
         // Fill index buffer
         glGenBuffers(1, &batch.vertexBuffer[i].vboId[3]);
@@ -2644,7 +2986,8 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
 #endif
     }
 
-    TRACELOG(RL_LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU)");
+    if (persistent) TRACELOG(RL_LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU) [%i persistent mapped buffers]", numBuffers);
+    else TRACELOG(RL_LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU)");
 
     // Unbind the current VAO
     if (RLGL.ExtSupported.vao) glBindVertexArray(0);
@@ -2662,6 +3005,7 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
         //batch.draws[i].vaoId = 0;
         //batch.draws[i].shaderId = 0;
         batch.draws[i].textureId = RLGL.State.defaultTextureId;
+        batch.draws[i].layer = RLGL.State.drawLayer;
         //batch.draws[i].RLGL.State.projection = rlMatrixIdentity();
         //batch.draws[i].RLGL.State.modelview = rlMatrixIdentity();
     }
@@ -2669,6 +3013,7 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
     batch.bufferCount = numBuffers;    // Record buffer count
     batch.drawCounter = 1;             // Reset draws counter
     batch.currentDepth = -1.0f;         // Reset depth value
+    batch.vertexFormat = vertexFormat; // Record vertex format
     //--------------------------------------------------------------------------------------------
 #endif
 
@@ -2697,6 +3042,21 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
             glBindVertexArray(0);
         }
 
+#if defined(GRAPHICS_API_OPENGL_33)
+        // Unmap persistent buffers and release last draw fence
+        for (int k = 0; k < 3; k++)
+        {
+            if (batch.vertexBuffer[i].mapped[k] != NULL)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[k]);
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+            }
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        if (batch.vertexBuffer[i].fence != NULL) glDeleteSync((GLsync)batch.vertexBuffer[i].fence);
+#endif
+
         // Delete VBOs from GPU (VRAM)
         glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[0]);
         glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[1]);
@@ -2711,6 +3071,7 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
         RL_FREE(batch.vertexBuffer[i].texcoords);
         RL_FREE(batch.vertexBuffer[i].colors);
         RL_FREE(batch.vertexBuffer[i].indices);
+        RL_FREE(batch.vertexBuffer[i].packed);
     }
 
     // Unload arrays
@@ -2724,47 +3085,106 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
 void rlDrawRenderBatch(rlRenderBatch *batch)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    // Sort deferred draws, counting draws before and after
+    //------------------------------------------------------------------------------------------------------------
+    for (int i = 0; i < batch->drawCounter; i++) if (batch->draws[i].vertexCount > 0) RLGL.State.drawCallsRecorded++;
+
+    if (RLGL.State.textureAliasCount > 0) rlResolveTextureAliases(batch);
+    if (RLGL.State.deferredDraws && (batch->drawCounter > 1)) rlSortRenderBatch(batch);
+
+    for (int i = 0; i < batch->drawCounter; i++) if (batch->draws[i].vertexCount > 0) RLGL.State.drawCallsSubmitted++;
+    //------------------------------------------------------------------------------------------------------------
+
     // Update batch vertex buffers
     //------------------------------------------------------------------------------------------------------------
     // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
     // TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (use a change detector flag?)
     if (RLGL.State.vertexCounter > 0)
     {
-        // Activate elements VAO
-        if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
-
-        // Vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
-
-        // Texture coordinates buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
-
-        // Colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
-
-        // NOTE: glMapBuffer() causes sync issue.
-        // If GPU is working with this buffer, glMapBuffer() will wait(stall) until GPU to finish its job.
-        // To avoid waiting (idle), you can call first glBufferData() with NULL pointer before glMapBuffer().
-        // If you do that, the previous data in PBO will be discarded and glMapBuffer() returns a new
-        // allocated pointer immediately even if GPU is still working with the previous data.
-
-        // Another option: map the buffer object into client's memory
-        // Probably this code could be moved somewhere else...
-        // batch->vertexBuffer[batch->currentBuffer].vertices = (float *)glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
-        // if (batch->vertexBuffer[batch->currentBuffer].vertices)
-        // {
-            // Update vertex data
-        // }
-        // glUnmapBuffer(GL_ARRAY_BUFFER);
-
-        // Unbind the current VAO
-        if (RLGL.ExtSupported.vao) glBindVertexArray(0);
+#if defined(GRAPHICS_API_OPENGL_33)
+        rlVertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+
+        // Check the GPU is done with the last draw from this buffer
+        // NOTE: Persistent mapped buffers are written directly so the CPU must wait,
+        // otherwise the driver resolves it (stalling or copying) on glBufferSubData()
+        if (buffer->fence != NULL)
+        {
+            GLenum result = glClientWaitSync((GLsync)buffer->fence, 0, 0);
+
+            if ((result == GL_TIMEOUT_EXPIRED) || (result == GL_WAIT_FAILED))
+            {
+                RLGL.State.batchStalls++;
+
+                if (buffer->mapped[0] != NULL)
+                {
+                    while (glClientWaitSync((GLsync)buffer->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) { }
+                }
+            }
+
+            glDeleteSync((GLsync)buffer->fence);
+            buffer->fence = NULL;
+        }
+
+        if ((buffer->mapped[0] != NULL) && (batch->vertexFormat != RL_BATCH_VERTEX_SEPARATE))
+        {
+            rlPackBatchVertices(buffer, batch->vertexFormat, RLGL.State.vertexCounter, (unsigned char *)buffer->mapped[0]);
+        }
+        else if (buffer->mapped[0] != NULL)
+        {
+            // Persistent mapped buffers are coherent, copied data is visible to next draw
+            // NOTE: Separate buffers are all mapped or none, see rlLoadRenderBatchFormat()
+            memcpy(buffer->mapped[0], buffer->vertices, RLGL.State.vertexCounter*3*sizeof(float));
+            memcpy(buffer->mapped[1], buffer->texcoords, RLGL.State.vertexCounter*2*sizeof(float));
+            memcpy(buffer->mapped[2], buffer->colors, RLGL.State.vertexCounter*4*sizeof(unsigned char));
+        }
+        else
+#endif
+        if (batch->vertexFormat != RL_BATCH_VERTEX_SEPARATE)
+        {
+            rlVertexBuffer *packedBuffer = &batch->vertexBuffer[batch->currentBuffer];
+            rlPackBatchVertices(packedBuffer, batch->vertexFormat, RLGL.State.vertexCounter, packedBuffer->packed);
+
+            glBindBuffer(GL_ARRAY_BUFFER, packedBuffer->vboId[0]);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*rlGetBatchVertexStride(batch->vertexFormat), packedBuffer->packed);
+        }
+        else
+        {
+            // Activate elements VAO
+            if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
+
+            // Vertex positions buffer
+            glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
+            //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
+
+            // Texture coordinates buffer
+            glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
+            //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
+
+            // Colors buffer
+            glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
+            //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
+
+            // NOTE: glMapBuffer() causes sync issue.
+            // If GPU is working with this buffer, glMapBuffer() will wait(stall) until GPU to finish its job.
+            // To avoid waiting (idle), you can call first glBufferData() with NULL pointer before glMapBuffer().
+            // If you do that, the previous data in PBO will be discarded and glMapBuffer() returns a new
+            // allocated pointer immediately even if GPU is still working with the previous data.
+
+            // Another option: map the buffer object into client's memory
+            // Probably this code could be moved somewhere else...
+            // batch->vertexBuffer[batch->currentBuffer].vertices = (float *)glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
+            // if (batch->vertexBuffer[batch->currentBuffer].vertices)
+            // {
+                // Update vertex data
+            // }
+            // glUnmapBuffer(GL_ARRAY_BUFFER);
+
+            // Unbind the current VAO
+            if (RLGL.ExtSupported.vao) glBindVertexArray(0);
+        }
     }
     //------------------------------------------------------------------------------------------------------------
 
@@ -2808,20 +3228,24 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
             if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
             else
             {
-                // Bind vertex attrib: position (shader-location = 0)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
-
-                // Bind vertex attrib: texcoord (shader-location = 1)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
-
-                // Bind vertex attrib: color (shader-location = 3)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+                if (batch->vertexFormat != RL_BATCH_VERTEX_SEPARATE) rlSetBatchCompactAttribs(batch->vertexBuffer[batch->currentBuffer].vboId[0], batch->vertexFormat);
+                else
+                {
+                    // Bind vertex attrib: position (shader-location = 0)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
+
+                    // Bind vertex attrib: texcoord (shader-location = 1)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+
+                    // Bind vertex attrib: color (shader-location = 3)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+                }
 
                 glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
             }
@@ -2883,6 +3307,15 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
 
     // Restore viewport to default measures
     if (eyeCount == 2) rlViewport(0, 0, RLGL.State.framebufferWidth, RLGL.State.framebufferHeight);
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    // Fence the draws, buffer will be checked before it is written again
+    // NOTE: Only useful with multi-buffering, a single buffer is always written next
+    if (RLGL.ExtSupported.sync && (batch->bufferCount > 1) && (RLGL.State.vertexCounter > 0))
+    {
+        batch->vertexBuffer[batch->currentBuffer].fence = (void *)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#endif
     //------------------------------------------------------------------------------------------------------------
 
     // Reset batch buffers
@@ -2903,6 +3336,7 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
         batch->draws[i].mode = RL_QUADS;
         batch->draws[i].vertexCount = 0;
         batch->draws[i].textureId = RLGL.State.defaultTextureId;
+        batch->draws[i].layer = RLGL.State.drawLayer;
     }
 
     // Reset active texture units for next batch
@@ -2937,6 +3371,19 @@ void rlDrawRenderBatchActive(void)
 #endif
 }
 
+// Get number of render batch uploads that found the GPU still reading the buffer
+// NOTE: Counted on multi-buffered batches (OpenGL 3.3+), on persistent mapped buffers the CPU waited
+unsigned int rlGetRenderBatchStalls(void)
+{
+    unsigned int stalls = 0;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    stalls = RLGL.State.batchStalls;
+#endif
+
+    return stalls;
+}
+
 // Check internal buffer overflow for a given number of vertex
 // and force a rlRenderBatch draw call if required
 bool rlCheckRenderBatchLimit(int vCount)
@@ -3343,6 +3790,17 @@ void rlGetGlTextureFormats(int format, unsigned int *glInternalFormat, unsigned
 // Unload texture from GPU memory
 void rlUnloadTexture(unsigned int id)
 {
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    // Remove aliases of the texture or drawn from it
+    for (int i = RLGL.State.textureAliasCount - 1; i >= 0; i--)
+    {
+        if ((RLGL.State.textureAliases[i].id == id) || (RLGL.State.textureAliases[i].atlasId == id))
+        {
+            rlDrawRenderBatch(RLGL.currentBatch);
+            RLGL.State.textureAliases[i] = RLGL.State.textureAliases[--RLGL.State.textureAliasCount];
+        }
+    }
+#endif
     glDeleteTextures(1, &id);
 }
 
@@ -4688,6 +5146,249 @@ static void rlUnloadShaderDefault(void)
     TRACELOG(RL_LOG_INFO, "SHADER: [ID %i] Default shader unloaded successfully", RLGL.State.defaultShaderId);
 }
 
+// Load immutable storage for the bound GL_ARRAY_BUFFER and map it persistently
+// NOTE: Mapping is coherent, CPU writes are visible to following draws without explicit flush,
+// dynamic storage is kept so glBufferSubData() still works in case mapping fails
+static void *rlLoadPersistentBuffer(int size, const void *data)
+{
+    void *mapped = NULL;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glBufferStorage(GL_ARRAY_BUFFER, size, data, flags | GL_DYNAMIC_STORAGE_BIT);
+    mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+
+    if (mapped == NULL) TRACELOG(RL_LOG_WARNING, "RLGL: Failed to map render batch buffer persistently");
+#endif
+
+    return mapped;
+}
+
+// Redirect batch draws of aliased textures to their atlas, merging adjacent ones
+// NOTE: Texcoords are mapped to the atlas region in place, draws are merged when they share
+// layer, texture and mode and the previous one has no alignment vertex in between
+static void rlResolveTextureAliases(rlRenderBatch *batch)
+{
+    rlVertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+    int drawCounter = 0;
+
+    for (int i = 0, offset = 0; i < batch->drawCounter; i++)
+    {
+        rlDrawCall draw = batch->draws[i];
+
+        for (int k = 0; k < RLGL.State.textureAliasCount; k++)
+        {
+            const rlTextureAlias *alias = &RLGL.State.textureAliases[k];
+            if (alias->id != draw.textureId) continue;
+
+            float *texcoords = buffer->texcoords + 2*offset;
+            for (int v = 0; v < draw.vertexCount; v++)
+            {
+                texcoords[2*v] = alias->x + texcoords[2*v]*alias->width;
+                texcoords[2*v + 1] = alias->y + texcoords[2*v + 1]*alias->height;
+            }
+
+            draw.textureId = alias->atlasId;
+            break;
+        }
+
+        offset += (draw.vertexCount + draw.vertexAlignment);
+
+        rlDrawCall *previous = (drawCounter > 0)? &batch->draws[drawCounter - 1] : NULL;
+
+        if ((previous != NULL) && (previous->vertexAlignment == 0) && (previous->mode == draw.mode) &&
+            (previous->textureId == draw.textureId) && (previous->layer == draw.layer))
+        {
+            previous->vertexCount += draw.vertexCount;
+            previous->vertexAlignment = draw.vertexAlignment;
+        }
+        else batch->draws[drawCounter++] = draw;
+    }
+
+    batch->drawCounter = drawCounter;
+}
+
+// Get batch vertex size in bytes for a compact vertex format
+static int rlGetBatchVertexStride(int vertexFormat)
+{
+    int positionSize = (vertexFormat == RL_BATCH_VERTEX_COMPACT_2D)? 2 : 3;
+
+    return positionSize*sizeof(float) + 2*sizeof(unsigned short) + 4*sizeof(unsigned char);
+}
+
+// Set batch vertex attributes for a compact vertex format, reading from the interleaved VBO
+// NOTE: Default shader inputs need no change, missing position Z defaults to 0.0 and
+// normalized short texcoords are read as float
+static void rlSetBatchCompactAttribs(unsigned int vboId, int vertexFormat)
+{
+    int positionSize = (vertexFormat == RL_BATCH_VERTEX_COMPACT_2D)? 2 : 3;
+    int stride = rlGetBatchVertexStride(vertexFormat);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vboId);
+
+    // Vertex position (shader-location = 0)
+    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], positionSize, GL_FLOAT, GL_FALSE, stride, 0);
+    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
+
+    // Vertex texcoord (shader-location = 1)
+    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void *)(positionSize*sizeof(float)));
+    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+
+    // Vertex color (shader-location = 3)
+    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void *)(positionSize*sizeof(float) + 2*sizeof(unsigned short)));
+    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+}
+
+// Pack batch vertices for a compact vertex format, interleaved
+// NOTE: Texcoords are clamped to [0..1]
+static void rlPackBatchVertices(const rlVertexBuffer *buffer, int vertexFormat, int count, unsigned char *packed)
+{
+    const float *vertices = buffer->vertices;
+    const float *texcoords = buffer->texcoords;
+    const unsigned char *colors = buffer->colors;
+    int stride = rlGetBatchVertexStride(vertexFormat);
+    int positionBytes = stride - 2*sizeof(unsigned short) - 4*sizeof(unsigned char);
+
+    for (int i = 0; i < count; i++, packed += stride)
+    {
+        float u = texcoords[2*i];
+        float v = texcoords[2*i + 1];
+        u = (u < 0.0f)? 0.0f : (u > 1.0f)? 1.0f : u;
+        v = (v < 0.0f)? 0.0f : (v > 1.0f)? 1.0f : v;
+
+        unsigned short texcoord[2] = { (unsigned short)(u*65535.0f + 0.5f), (unsigned short)(v*65535.0f + 0.5f) };
+
+        // Position Z is written and then overwritten by texcoords on 2d format
+        memcpy(packed, vertices + 3*i, 3*sizeof(float));
+        memcpy(packed + positionBytes, texcoord, 2*sizeof(unsigned short));
+        memcpy(packed + positionBytes + 2*sizeof(unsigned short), colors + 4*i, 4*sizeof(unsigned char));
+    }
+}
+
+// Sort batch draws by layer, texture and mode, merging the ones sharing them
+// NOTE: Sort is stable, draws with the same key keep submission order. Vertices are gathered
+// in sorted order into the sorting buffer, then swapped with the batch buffer
+static void rlSortRenderBatch(rlRenderBatch *batch)
+{
+    rlVertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+    int capacity = buffer->elementCount*4;
+
+    rlDrawCall draws[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    int offsets[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    int order[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    int count = 0;
+
+    for (int i = 0, offset = 0; i < batch->drawCounter; i++)
+    {
+        draws[i] = batch->draws[i];
+        offsets[i] = offset;
+        offset += (batch->draws[i].vertexCount + batch->draws[i].vertexAlignment);
+
+        if (batch->draws[i].vertexCount > 0) order[count++] = i;
+    }
+
+    // Insertion sort, a batch has few draws and they are mostly sorted already
+    for (int i = 1; i < count; i++)
+    {
+        int draw = order[i];
+        int j = i - 1;
+
+        while (j >= 0)
+        {
+            const rlDrawCall *a = &draws[order[j]];
+            const rlDrawCall *b = &draws[draw];
+
+            bool greater = (a->layer != b->layer)? (a->layer > b->layer) :
+                           (a->textureId != b->textureId)? (a->textureId > b->textureId) : (a->mode > b->mode);
+            if (!greater) break;
+
+            order[j + 1] = order[j];
+            j--;
+        }
+
+        order[j + 1] = draw;
+    }
+
+    // Check merged draws fit, draws are padded to start aligned to quads
+    int total = 0;
+    for (int i = 0; i < count;)
+    {
+        int vertexCount = 0;
+        int j = i;
+
+        for (; (j < count) && (draws[order[j]].layer == draws[order[i]].layer) &&
+            (draws[order[j]].textureId == draws[order[i]].textureId) && (draws[order[j]].mode == draws[order[i]].mode); j++)
+        {
+            vertexCount += draws[order[j]].vertexCount;
+        }
+
+        total += vertexCount + (4 - vertexCount%4)%4;
+        i = j;
+    }
+
+    if (total > capacity) return;
+
+    if (RLGL.State.sortCapacity != capacity)
+    {
+        RL_FREE(RLGL.State.sortVertices);
+        RL_FREE(RLGL.State.sortTexcoords);
+        RL_FREE(RLGL.State.sortColors);
+
+        RLGL.State.sortVertices = (float *)RL_MALLOC(capacity*3*sizeof(float));
+        RLGL.State.sortTexcoords = (float *)RL_MALLOC(capacity*2*sizeof(float));
+        RLGL.State.sortColors = (unsigned char *)RL_MALLOC(capacity*4*sizeof(unsigned char));
+        RLGL.State.sortCapacity = capacity;
+    }
+
+    // Gather vertices of every merged draw
+    int drawCounter = 0;
+    int vertexCounter = 0;
+
+    for (int i = 0; i < count;)
+    {
+        rlDrawCall *merged = &batch->draws[drawCounter];
+        *merged = draws[order[i]];
+        merged->vertexCount = 0;
+
+        int j = i;
+        for (; (j < count) && (draws[order[j]].layer == merged->layer) &&
+            (draws[order[j]].textureId == merged->textureId) && (draws[order[j]].mode == merged->mode); j++)
+        {
+            int src = offsets[order[j]];
+            int dst = vertexCounter + merged->vertexCount;
+            int n = draws[order[j]].vertexCount;
+
+            memcpy(RLGL.State.sortVertices + 3*dst, buffer->vertices + 3*src, n*3*sizeof(float));
+            memcpy(RLGL.State.sortTexcoords + 2*dst, buffer->texcoords + 2*src, n*2*sizeof(float));
+            memcpy(RLGL.State.sortColors + 4*dst, buffer->colors + 4*src, n*4*sizeof(unsigned char));
+
+            merged->vertexCount += n;
+        }
+
+        merged->vertexAlignment = (4 - merged->vertexCount%4)%4;
+        vertexCounter += (merged->vertexCount + merged->vertexAlignment);
+        drawCounter++;
+        i = j;
+    }
+
+    // Swap sorted vertex data into the batch buffer
+    float *vertices = buffer->vertices;
+    float *texcoords = buffer->texcoords;
+    unsigned char *colors = buffer->colors;
+
+    buffer->vertices = RLGL.State.sortVertices;
+    buffer->texcoords = RLGL.State.sortTexcoords;
+    buffer->colors = RLGL.State.sortColors;
+
+    RLGL.State.sortVertices = vertices;
+    RLGL.State.sortTexcoords = texcoords;
+    RLGL.State.sortColors = colors;
+
+    batch->drawCounter = (drawCounter > 0)? drawCounter : 1;
+    RLGL.State.vertexCounter = vertexCounter;
+}
+
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 // Get compressed format official GL identifier name
 static const char *rlGetCompressedFormatName(int format)
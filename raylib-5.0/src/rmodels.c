@@ -57,6 +57,7 @@
 #include <stdlib.h>         // Required for: malloc(), free()
 #include <string.h>         // Required for: memcmp(), strlen()
 #include <math.h>           // Required for: sinf(), cosf(), sqrtf(), fabsf()
+#include <float.h>          // Required for: FLT_MAX [Used in GenMeshBVH(), GetRayCollisionMesh()]
 
 #if defined(SUPPORT_FILEFORMAT_OBJ) || defined(SUPPORT_FILEFORMAT_MTL)
     #define TINYOBJ_MALLOC RL_MALLOC
@@ -132,16 +133,74 @@
 #ifndef MAX_MESH_VERTEX_BUFFERS
     #define MAX_MESH_VERTEX_BUFFERS  7    // Maximum vertex buffers (VBO) per mesh
 #endif
+#ifndef MAX_MESH_BVH_LEAF_TRIANGLES
+    #define MAX_MESH_BVH_LEAF_TRIANGLES  4    // Maximum triangles per mesh BVH leaf node
+#endif
+#ifndef MAX_GEOMETRY_TEMPLATES
+    #define MAX_GEOMETRY_TEMPLATES      16    // Maximum sphere/cylinder geometry templates cached
+#endif
+
+#define MESH_BVH_BINS           16      // Centroid bins tested per axis when splitting a BVH node
+#define MESH_BVH_STACK_SIZE     64      // Maximum BVH depth, deeper nodes become leaves
+
+#define GEOMETRY_SPAN_MAX_VERTICES  3072    // Maximum template vertices reserved in the render batch at once (whole triangles)
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// ...
+// Mesh BVH node
+// NOTE: Children of an inner node are stored consecutively
+typedef struct rMeshBVHNode {
+    Vector3 min;            // Node bounds minimum
+    Vector3 max;            // Node bounds maximum
+    int first;              // Inner node: first child index, leaf node: first triangle in triangles[]
+    int count;              // Inner node: 0, leaf node: number of triangles
+} rMeshBVHNode;
+
+// Mesh BVH, built in mesh local space by GenMeshBVH()
+struct rMeshBVH {
+    rMeshBVHNode *nodes;    // Nodes array, nodes[0] is the root
+    int nodeCount;          // Number of nodes used
+    int *triangles;         // Triangle indices, grouped by leaf
+};
+
+// Geometry template type
+typedef enum {
+    GEOMETRY_SPHERE = 0,    // Unit radius sphere, centered
+    GEOMETRY_CYLINDER,      // Unit radius cylinder, base at Y 0 and top at Y 1
+    GEOMETRY_CONE           // Unit radius cone, base at Y 0 and apex at Y 1
+} GeometryTemplateType;
+
+// Unit geometry template, triangles generated once and scaled on drawing
+typedef struct GeometryTemplate {
+    int type;               // Geometry type (GeometryTemplateType)
+    int rings;              // Sphere rings, 0 for cylinders and cones
+    int slices;             // Sphere slices or cylinder/cone sides
+    int vertexCount;        // Number of vertices (triangles*3)
+    float *vertices;        // Vertex positions (XYZ), NULL for an empty cache slot
+} GeometryTemplate;
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
-// ...
+// Unit cube, centered, triangles in the same order DrawCube() used to submit them
+static const float cubeVertices[36*3] = {
+    -0.5f, -0.5f,  0.5f,   0.5f, -0.5f,  0.5f,  -0.5f,  0.5f,  0.5f,     // Front face
+     0.5f,  0.5f,  0.5f,  -0.5f,  0.5f,  0.5f,   0.5f, -0.5f,  0.5f,
+    -0.5f, -0.5f, -0.5f,  -0.5f,  0.5f, -0.5f,   0.5f, -0.5f, -0.5f,     // Back face
+     0.5f,  0.5f, -0.5f,   0.5f, -0.5f, -0.5f,  -0.5f,  0.5f, -0.5f,
+    -0.5f,  0.5f, -0.5f,  -0.5f,  0.5f,  0.5f,   0.5f,  0.5f,  0.5f,     // Top face
+     0.5f,  0.5f, -0.5f,  -0.5f,  0.5f, -0.5f,   0.5f,  0.5f,  0.5f,
+    -0.5f, -0.5f, -0.5f,   0.5f, -0.5f,  0.5f,  -0.5f, -0.5f,  0.5f,     // Bottom face
+     0.5f, -0.5f, -0.5f,   0.5f, -0.5f,  0.5f,  -0.5f, -0.5f, -0.5f,
+     0.5f, -0.5f, -0.5f,   0.5f,  0.5f, -0.5f,   0.5f,  0.5f,  0.5f,     // Right face
+     0.5f, -0.5f,  0.5f,   0.5f, -0.5f, -0.5f,   0.5f,  0.5f,  0.5f,
+    -0.5f, -0.5f, -0.5f,  -0.5f,  0.5f,  0.5f,  -0.5f,  0.5f, -0.5f,     // Left face
+    -0.5f, -0.5f,  0.5f,  -0.5f,  0.5f,  0.5f,  -0.5f, -0.5f, -0.5f
+};
+
+static GeometryTemplate geometryTemplates[MAX_GEOMETRY_TEMPLATES] = { 0 };  // Sphere/cylinder templates cache
+static int geometryTemplateNext = 0;    // Cache slot replaced next when all slots are used
 
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
@@ -167,6 +226,12 @@ static ModelAnimation *LoadModelAnimationsM3D(const char *fileName, int *animCou
 #if defined(SUPPORT_FILEFORMAT_OBJ) || defined(SUPPORT_FILEFORMAT_MTL)
 static void ProcessMaterialsOBJ(Material *rayMaterials, tinyobj_material_t *materials, int materialCount);  // Process obj materials
 #endif
+static void GetMeshTriangle(Mesh mesh, int index, Vector3 *a, Vector3 *b, Vector3 *c);  // Get mesh triangle vertices
+static float GetBoxHalfArea(Vector3 min, Vector3 max);                                  // Get half the surface area of a box
+static float GetRayBoxDistance(Vector3 origin, Vector3 invDirection, Vector3 min, Vector3 max); // Get ray distance to box, FLT_MAX if not hit
+static RayCollision GetRayCollisionMeshBVH(Ray ray, Mesh mesh, Matrix transform);     // Get collision info between ray and mesh using its BVH
+static const GeometryTemplate *GetGeometryTemplate(int type, int rings, int slices);   // Get unit geometry template, generated on first use
+static void DrawGeometryTemplate(const float *vertices, int vertexCount, Vector3 position, Vector3 scale, float taper, Color color);  // Draw template triangles scaled and placed
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -255,74 +320,7 @@ void DrawTriangleStrip3D(Vector3 *points, int pointCount, Color color)
 // NOTE: Cube position is the center position
 void DrawCube(Vector3 position, float width, float height, float length, Color color)
 {
-    float x = 0.0f;
-    float y = 0.0f;
-    float z = 0.0f;
-
-    rlPushMatrix();
-        // NOTE: Transformation is applied in inverse order (scale -> rotate -> translate)
-        rlTranslatef(position.x, position.y, position.z);
-        //rlRotatef(45, 0, 1, 0);
-        //rlScalef(1.0f, 1.0f, 1.0f);   // NOTE: Vertices are directly scaled on definition
-
-        rlBegin(RL_TRIANGLES);
-            rlColor4ub(color.r, color.g, color.b, color.a);
-
-            // Front face
-            rlVertex3f(x - width/2, y - height/2, z + length/2);  // Bottom Left
-            rlVertex3f(x + width/2, y - height/2, z + length/2);  // Bottom Right
-            rlVertex3f(x - width/2, y + height/2, z + length/2);  // Top Left
-
-            rlVertex3f(x + width/2, y + height/2, z + length/2);  // Top Right
-            rlVertex3f(x - width/2, y + height/2, z + length/2);  // Top Left
-            rlVertex3f(x + width/2, y - height/2, z + length/2);  // Bottom Right
-
-            // Back face
-            rlVertex3f(x - width/2, y - height/2, z - length/2);  // Bottom Left
-            rlVertex3f(x - width/2, y + height/2, z - length/2);  // Top Left
-            rlVertex3f(x + width/2, y - height/2, z - length/2);  // Bottom Right
-
-            rlVertex3f(x + width/2, y + height/2, z - length/2);  // Top Right
-            rlVertex3f(x + width/2, y - height/2, z - length/2);  // Bottom Right
-            rlVertex3f(x - width/2, y + height/2, z - length/2);  // Top Left
-
-            // Top face
-            rlVertex3f(x - width/2, y + height/2, z - length/2);  // Top Left
-            rlVertex3f(x - width/2, y + height/2, z + length/2);  // Bottom Left
-            rlVertex3f(x + width/2, y + height/2, z + length/2);  // Bottom Right
-
-            rlVertex3f(x + width/2, y + height/2, z - length/2);  // Top Right
-            rlVertex3f(x - width/2, y + height/2, z - length/2);  // Top Left
-            rlVertex3f(x + width/2, y + height/2, z + length/2);  // Bottom Right
-
-            // Bottom face
-            rlVertex3f(x - width/2, y - height/2, z - length/2);  // Top Left
-            rlVertex3f(x + width/2, y - height/2, z + length/2);  // Bottom Right
-            rlVertex3f(x - width/2, y - height/2, z + length/2);  // Bottom Left
-
-            rlVertex3f(x + width/2, y - height/2, z - length/2);  // Top Right
-            rlVertex3f(x + width/2, y - height/2, z + length/2);  // Bottom Right
-            rlVertex3f(x - width/2, y - height/2, z - length/2);  // Top Left
-
-            // Right face
-            rlVertex3f(x + width/2, y - height/2, z - length/2);  // Bottom Right
-            rlVertex3f(x + width/2, y + height/2, z - length/2);  // Top Right
-            rlVertex3f(x + width/2, y + height/2, z + length/2);  // Top Left
-
-            rlVertex3f(x + width/2, y - height/2, z + length/2);  // Bottom Left
-            rlVertex3f(x + width/2, y - height/2, z - length/2);  // Bottom Right
-            rlVertex3f(x + width/2, y + height/2, z + length/2);  // Top Left
-
-            // Left face
-            rlVertex3f(x - width/2, y - height/2, z - length/2);  // Bottom Right
-            rlVertex3f(x - width/2, y + height/2, z + length/2);  // Top Left
-            rlVertex3f(x - width/2, y + height/2, z - length/2);  // Top Right
-
-            rlVertex3f(x - width/2, y - height/2, z + length/2);  // Bottom Left
-            rlVertex3f(x - width/2, y + height/2, z + length/2);  // Top Left
-            rlVertex3f(x - width/2, y - height/2, z - length/2);  // Bottom Right
-        rlEnd();
-    rlPopMatrix();
+    DrawGeometryTemplate(cubeVertices, 36, position, (Vector3){ width, height, length }, 0.0f, color);
 }
 
 // Draw cube (Vector version)
@@ -418,41 +416,9 @@ void DrawSphere(Vector3 centerPos, float radius, Color color)
 // Draw sphere with extended parameters
 void DrawSphereEx(Vector3 centerPos, float radius, int rings, int slices, Color color)
 {
-    rlPushMatrix();
-        // NOTE: Transformation is applied in inverse order (scale -> translate)
-        rlTranslatef(centerPos.x, centerPos.y, centerPos.z);
-        rlScalef(radius, radius, radius);
-
-        rlBegin(RL_TRIANGLES);
-            rlColor4ub(color.r, color.g, color.b, color.a);
-
-            for (int i = 0; i < (rings + 2); i++)
-            {
-                for (int j = 0; j < slices; j++)
-                {
-                    rlVertex3f(cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*i))*sinf(DEG2RAD*(360.0f*j/slices)),
-                               sinf(DEG2RAD*(270 + (180.0f/(rings + 1))*i)),
-                               cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*i))*cosf(DEG2RAD*(360.0f*j/slices)));
-                    rlVertex3f(cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1)))*sinf(DEG2RAD*(360.0f*(j + 1)/slices)),
-                               sinf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1))),
-                               cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1)))*cosf(DEG2RAD*(360.0f*(j + 1)/slices)));
-                    rlVertex3f(cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1)))*sinf(DEG2RAD*(360.0f*j/slices)),
-                               sinf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1))),
-                               cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1)))*cosf(DEG2RAD*(360.0f*j/slices)));
+    const GeometryTemplate *sphere = GetGeometryTemplate(GEOMETRY_SPHERE, rings, slices);
 
-                    rlVertex3f(cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*i))*sinf(DEG2RAD*(360.0f*j/slices)),
-                               sinf(DEG2RAD*(270 + (180.0f/(rings + 1))*i)),
-                               cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*i))*cosf(DEG2RAD*(360.0f*j/slices)));
-                    rlVertex3f(cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i)))*sinf(DEG2RAD*(360.0f*(j + 1)/slices)),
-                               sinf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i))),
-                               cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i)))*cosf(DEG2RAD*(360.0f*(j + 1)/slices)));
-                    rlVertex3f(cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1)))*sinf(DEG2RAD*(360.0f*(j + 1)/slices)),
-                               sinf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1))),
-                               cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1)))*cosf(DEG2RAD*(360.0f*(j + 1)/slices)));
-                }
-            }
-        rlEnd();
-    rlPopMatrix();
+    if (sphere != NULL) DrawGeometryTemplate(sphere->vertices, sphere->vertexCount, centerPos, (Vector3){ radius, radius, radius }, 0.0f, color);
 }
 
 // Draw sphere wires
@@ -502,54 +468,13 @@ void DrawCylinder(Vector3 position, float radiusTop, float radiusBottom, float h
 {
     if (sides < 3) sides = 3;
 
-    rlPushMatrix();
-        rlTranslatef(position.x, position.y, position.z);
-
-        rlBegin(RL_TRIANGLES);
-            rlColor4ub(color.r, color.g, color.b, color.a);
-
-            if (radiusTop > 0)
-            {
-                // Draw Body -------------------------------------------------------------------------------------
-                for (int i = 0; i < 360; i += 360/sides)
-                {
-                    rlVertex3f(sinf(DEG2RAD*i)*radiusBottom, 0, cosf(DEG2RAD*i)*radiusBottom); //Bottom Left
-                    rlVertex3f(sinf(DEG2RAD*(i + 360.0f/sides))*radiusBottom, 0, cosf(DEG2RAD*(i + 360.0f/sides))*radiusBottom); //Bottom Right
-                    rlVertex3f(sinf(DEG2RAD*(i + 360.0f/sides))*radiusTop, height, cosf(DEG2RAD*(i + 360.0f/sides))*radiusTop); //Top Right
-
-                    rlVertex3f(sinf(DEG2RAD*i)*radiusTop, height, cosf(DEG2RAD*i)*radiusTop); //Top Left
-                    rlVertex3f(sinf(DEG2RAD*i)*radiusBottom, 0, cosf(DEG2RAD*i)*radiusBottom); //Bottom Left
-                    rlVertex3f(sinf(DEG2RAD*(i + 360.0f/sides))*radiusTop, height, cosf(DEG2RAD*(i + 360.0f/sides))*radiusTop); //Top Right
-                }
-
-                // Draw Cap --------------------------------------------------------------------------------------
-                for (int i = 0; i < 360; i += 360/sides)
-                {
-                    rlVertex3f(0, height, 0);
-                    rlVertex3f(sinf(DEG2RAD*i)*radiusTop, height, cosf(DEG2RAD*i)*radiusTop);
-                    rlVertex3f(sinf(DEG2RAD*(i + 360.0f/sides))*radiusTop, height, cosf(DEG2RAD*(i + 360.0f/sides))*radiusTop);
-                }
-            }
-            else
-            {
-                // Draw Cone -------------------------------------------------------------------------------------
-                for (int i = 0; i < 360; i += 360/sides)
-                {
-                    rlVertex3f(0, height, 0);
-                    rlVertex3f(sinf(DEG2RAD*i)*radiusBottom, 0, cosf(DEG2RAD*i)*radiusBottom);
-                    rlVertex3f(sinf(DEG2RAD*(i + 360.0f/sides))*radiusBottom, 0, cosf(DEG2RAD*(i + 360.0f/sides))*radiusBottom);
-                }
-            }
+    // NOTE: Cylinder template vertices are at Y 0 (bottom) or Y 1 (top),
+    // taper scales the top ring from bottom radius to top radius
+    const GeometryTemplate *cylinder = NULL;
+    if (radiusTop > 0) cylinder = GetGeometryTemplate(GEOMETRY_CYLINDER, 0, sides);
+    else cylinder = GetGeometryTemplate(GEOMETRY_CONE, 0, sides);
 
-            // Draw Base -----------------------------------------------------------------------------------------
-            for (int i = 0; i < 360; i += 360/sides)
-            {
-                rlVertex3f(0, 0, 0);
-                rlVertex3f(sinf(DEG2RAD*(i + 360.0f/sides))*radiusBottom, 0, cosf(DEG2RAD*(i + 360.0f/sides))*radiusBottom);
-                rlVertex3f(sinf(DEG2RAD*i)*radiusBottom, 0, cosf(DEG2RAD*i)*radiusBottom);
-            }
-        rlEnd();
-    rlPopMatrix();
+    if (cylinder != NULL) DrawGeometryTemplate(cylinder->vertices, cylinder->vertexCount, position, (Vector3){ radiusBottom, height, radiusBottom }, (radiusTop > 0)? (radiusTop - radiusBottom) : 0.0f, color);
 }
 
 // Draw a cylinder with base at startPos and top at endPos
@@ -1768,6 +1693,13 @@ void UnloadMesh(Mesh mesh)
     RL_FREE(mesh.animNormals);
     RL_FREE(mesh.boneWeights);
     RL_FREE(mesh.boneIds);
+
+    if (mesh.bvh != NULL)
+    {
+        RL_FREE(mesh.bvh->nodes);
+        RL_FREE(mesh.bvh->triangles);
+        RL_FREE(mesh.bvh);
+    }
 }
 
 // Export mesh data to file
@@ -3408,6 +3340,198 @@ void GenMeshTangents(Mesh *mesh)
     TRACELOG(LOG_INFO, "MESH: Tangents data computed and uploaded for provided mesh");
 }
 
+// Compute mesh bounding volume hierarchy
+// NOTE: Built from mesh vertices (not animVertices) in mesh local space, it must be
+// generated again if they change, GetRayCollisionMesh() uses it when available
+// Implementation based on binned SAH: https://jacco.ompf2.com/2022/04/18/how-to-build-a-bvh-part-2-faster-rays/
+void GenMeshBVH(Mesh *mesh)
+{
+    if ((mesh->vertices == NULL) || (mesh->triangleCount <= 0))
+    {
+        TRACELOG(LOG_WARNING, "MESH: BVH generation requires vertex position data");
+        return;
+    }
+
+    if (mesh->bvh != NULL)
+    {
+        RL_FREE(mesh->bvh->nodes);
+        RL_FREE(mesh->bvh->triangles);
+        RL_FREE(mesh->bvh);
+    }
+
+    int triangleCount = mesh->triangleCount;
+    rMeshBVH *bvh = (rMeshBVH *)RL_CALLOC(1, sizeof(rMeshBVH));
+    bvh->nodes = (rMeshBVHNode *)RL_MALLOC((2*triangleCount - 1)*sizeof(rMeshBVHNode));
+    bvh->triangles = (int *)RL_MALLOC(triangleCount*sizeof(int));
+
+    // Triangles bounds and centroids, only required while building
+    Vector3 *triMin = (Vector3 *)RL_MALLOC(triangleCount*sizeof(Vector3));
+    Vector3 *triMax = (Vector3 *)RL_MALLOC(triangleCount*sizeof(Vector3));
+    Vector3 *centroids = (Vector3 *)RL_MALLOC(triangleCount*sizeof(Vector3));
+
+    for (int i = 0; i < triangleCount; i++)
+    {
+        Vector3 a, b, c;
+        GetMeshTriangle(*mesh, i, &a, &b, &c);
+        triMin[i] = Vector3Min(a, Vector3Min(b, c));
+        triMax[i] = Vector3Max(a, Vector3Max(b, c));
+        centroids[i] = Vector3Scale(Vector3Add(a, Vector3Add(b, c)), 1.0f/3.0f);
+        bvh->triangles[i] = i;
+    }
+
+    // Root node contains all triangles
+    bvh->nodes[0].first = 0;
+    bvh->nodes[0].count = triangleCount;
+    bvh->nodeCount = 1;
+
+    // Nodes pending subdivision, depth first so it never holds more than depth + 1 nodes
+    int stack[MESH_BVH_STACK_SIZE] = { 0 };
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        int nodeIndex = stack[--stackSize];
+        int first = bvh->nodes[nodeIndex].first;
+        int count = bvh->nodes[nodeIndex].count;
+
+        // Get node bounds and its triangles centroids bounds
+        Vector3 min = { FLT_MAX, FLT_MAX, FLT_MAX };
+        Vector3 max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        Vector3 centroidMin = min;
+        Vector3 centroidMax = max;
+
+        for (int i = first; i < (first + count); i++)
+        {
+            int t = bvh->triangles[i];
+            min = Vector3Min(min, triMin[t]);
+            max = Vector3Max(max, triMax[t]);
+            centroidMin = Vector3Min(centroidMin, centroids[t]);
+            centroidMax = Vector3Max(centroidMax, centroids[t]);
+        }
+
+        bvh->nodes[nodeIndex].min = min;
+        bvh->nodes[nodeIndex].max = max;
+
+        if ((count <= MAX_MESH_BVH_LEAF_TRIANGLES) || ((stackSize + 2) > MESH_BVH_STACK_SIZE)) continue;
+
+        // Find the cheapest split plane between centroid bins (surface area heuristic),
+        // splitting must be cheaper than testing all the triangles of the node
+        float bestCost = count*GetBoxHalfArea(min, max);
+        int bestAxis = -1;
+        int bestBin = 0;
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float lower = ((float *)&centroidMin)[axis];
+            float upper = ((float *)&centroidMax)[axis];
+            if (upper <= lower) continue;
+
+            float scale = MESH_BVH_BINS/(upper - lower);
+            int binCount[MESH_BVH_BINS] = { 0 };
+            Vector3 binMin[MESH_BVH_BINS] = { 0 };
+            Vector3 binMax[MESH_BVH_BINS] = { 0 };
+
+            for (int i = first; i < (first + count); i++)
+            {
+                int t = bvh->triangles[i];
+                int bin = (int)((((float *)&centroids[t])[axis] - lower)*scale);
+                if (bin > (MESH_BVH_BINS - 1)) bin = MESH_BVH_BINS - 1;
+
+                binMin[bin] = (binCount[bin] == 0)? triMin[t] : Vector3Min(binMin[bin], triMin[t]);
+                binMax[bin] = (binCount[bin] == 0)? triMax[t] : Vector3Max(binMax[bin], triMax[t]);
+                binCount[bin]++;
+            }
+
+            // Accumulate bins from the left, then evaluate every plane sweeping from the right
+            int leftCount[MESH_BVH_BINS - 1] = { 0 };
+            float leftArea[MESH_BVH_BINS - 1] = { 0 };
+            Vector3 accumMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+            Vector3 accumMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            int accumCount = 0;
+
+            for (int bin = 0; bin < (MESH_BVH_BINS - 1); bin++)
+            {
+                if (binCount[bin] > 0)
+                {
+                    accumMin = Vector3Min(accumMin, binMin[bin]);
+                    accumMax = Vector3Max(accumMax, binMax[bin]);
+                    accumCount += binCount[bin];
+                }
+
+                leftCount[bin] = accumCount;
+                leftArea[bin] = (accumCount > 0)? GetBoxHalfArea(accumMin, accumMax) : 0.0f;
+            }
+
+            accumMin = (Vector3){ FLT_MAX, FLT_MAX, FLT_MAX };
+            accumMax = (Vector3){ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            accumCount = 0;
+
+            for (int bin = MESH_BVH_BINS - 1; bin > 0; bin--)
+            {
+                if (binCount[bin] > 0)
+                {
+                    accumMin = Vector3Min(accumMin, binMin[bin]);
+                    accumMax = Vector3Max(accumMax, binMax[bin]);
+                    accumCount += binCount[bin];
+                }
+
+                if ((leftCount[bin - 1] == 0) || (accumCount == 0)) continue;
+
+                float cost = leftCount[bin - 1]*leftArea[bin - 1] + accumCount*GetBoxHalfArea(accumMin, accumMax);
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+
+        if (bestAxis < 0) continue;     // No split is cheaper, keep it as a leaf
+
+        // Partition node triangles around the split plane
+        float lower = ((float *)&centroidMin)[bestAxis];
+        float scale = MESH_BVH_BINS/(((float *)&centroidMax)[bestAxis] - lower);
+        int i = first;
+        int j = first + count - 1;
+
+        while (i <= j)
+        {
+            int t = bvh->triangles[i];
+            int bin = (int)((((float *)&centroids[t])[bestAxis] - lower)*scale);
+            if (bin > (MESH_BVH_BINS - 1)) bin = MESH_BVH_BINS - 1;
+
+            if (bin < bestBin) i++;
+            else
+            {
+                bvh->triangles[i] = bvh->triangles[j];
+                bvh->triangles[j] = t;
+                j--;
+            }
+        }
+
+        int left = bvh->nodeCount;
+        bvh->nodeCount += 2;
+
+        bvh->nodes[left] = (rMeshBVHNode){ .first = first, .count = i - first };
+        bvh->nodes[left + 1] = (rMeshBVHNode){ .first = i, .count = first + count - i };
+        bvh->nodes[nodeIndex].first = left;
+        bvh->nodes[nodeIndex].count = 0;
+
+        stack[stackSize++] = left + 1;
+        stack[stackSize++] = left;
+    }
+
+    RL_FREE(triMin);
+    RL_FREE(triMax);
+    RL_FREE(centroids);
+
+    mesh->bvh = bvh;
+
+    TRACELOG(LOG_INFO, "MESH: BVH computed for provided mesh (%i triangles, %i nodes)", triangleCount, bvh->nodeCount);
+}
+
 // Draw a model (with texture if set)
 void DrawModel(Model model, Vector3 position, float scale, Color tint)
 {
@@ -3768,6 +3892,9 @@ RayCollision GetRayCollisionMesh(Ray ray, Mesh mesh, Matrix transform)
 {
     RayCollision collision = { 0 };
 
+    // Use mesh BVH when available, see GenMeshBVH()
+    if ((mesh.vertices != NULL) && (mesh.bvh != NULL)) return GetRayCollisionMeshBVH(ray, mesh, transform);
+
     // Check if mesh vertex data on CPU for testing
     if (mesh.vertices != NULL)
     {
@@ -3885,6 +4012,359 @@ RayCollision GetRayCollisionQuad(Ray ray, Vector3 p1, Vector3 p2, Vector3 p3, Ve
 //----------------------------------------------------------------------------------
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
+// Get unit geometry template, generated on first use
+// NOTE: When the cache is full the oldest template is replaced
+static const GeometryTemplate *GetGeometryTemplate(int type, int rings, int slices)
+{
+    int slot = -1;
+
+    for (int i = 0; i < MAX_GEOMETRY_TEMPLATES; i++)
+    {
+        GeometryTemplate *geometry = &geometryTemplates[i];
+
+        if (geometry->vertices == NULL)
+        {
+            if (slot < 0) slot = i;
+        }
+        else if ((geometry->type == type) && (geometry->rings == rings) && (geometry->slices == slices)) return geometry;
+    }
+
+    if (slot < 0)
+    {
+        slot = geometryTemplateNext;
+        geometryTemplateNext = (geometryTemplateNext + 1)%MAX_GEOMETRY_TEMPLATES;
+    }
+
+    GeometryTemplate *geometry = &geometryTemplates[slot];
+    RL_FREE(geometry->vertices);
+    *geometry = (GeometryTemplate){ type, rings, slices, 0, NULL };
+
+    if (type == GEOMETRY_SPHERE)
+    {
+        if ((rings < 0) || (slices <= 0)) return NULL;
+
+        geometry->vertexCount = (rings + 2)*slices*6;
+        geometry->vertices = (float *)RL_MALLOC(geometry->vertexCount*3*sizeof(float));
+        float *v = geometry->vertices;
+
+        for (int i = 0; i < (rings + 2); i++)
+        {
+            float ringCos0 = cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*i));
+            float ringSin0 = sinf(DEG2RAD*(270 + (180.0f/(rings + 1))*i));
+            float ringCos1 = cosf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1)));
+            float ringSin1 = sinf(DEG2RAD*(270 + (180.0f/(rings + 1))*(i + 1)));
+
+            for (int j = 0; j < slices; j++)
+            {
+                float sliceSin0 = sinf(DEG2RAD*(360.0f*j/slices));
+                float sliceCos0 = cosf(DEG2RAD*(360.0f*j/slices));
+                float sliceSin1 = sinf(DEG2RAD*(360.0f*(j + 1)/slices));
+                float sliceCos1 = cosf(DEG2RAD*(360.0f*(j + 1)/slices));
+
+                const float quad[6][3] = {
+                    { ringCos0*sliceSin0, ringSin0, ringCos0*sliceCos0 },
+                    { ringCos1*sliceSin1, ringSin1, ringCos1*sliceCos1 },
+                    { ringCos1*sliceSin0, ringSin1, ringCos1*sliceCos0 },
+                    { ringCos0*sliceSin0, ringSin0, ringCos0*sliceCos0 },
+                    { ringCos0*sliceSin1, ringSin0, ringCos0*sliceCos1 },
+                    { ringCos1*sliceSin1, ringSin1, ringCos1*sliceCos1 }
+                };
+
+                memcpy(v, quad, sizeof(quad));
+                v += 6*3;
+            }
+        }
+    }
+    else
+    {
+        // NOTE: Sides are walked in integer degrees, as DrawCylinder() always did
+        int steps = 0;
+        for (int i = 0; i < 360; i += 360/slices) steps++;
+
+        geometry->vertexCount = steps*((type == GEOMETRY_CYLINDER)? 12 : 6);
+        geometry->vertices = (float *)RL_MALLOC(geometry->vertexCount*3*sizeof(float));
+        float *v = geometry->vertices;
+
+        if (type == GEOMETRY_CYLINDER)
+        {
+            // Body, two triangles per side
+            for (int i = 0; i < 360; i += 360/slices)
+            {
+                float sin0 = sinf(DEG2RAD*i), cos0 = cosf(DEG2RAD*i);
+                float sin1 = sinf(DEG2RAD*(i + 360.0f/slices)), cos1 = cosf(DEG2RAD*(i + 360.0f/slices));
+
+                const float side[6][3] = {
+                    { sin0, 0.0f, cos0 }, { sin1, 0.0f, cos1 }, { sin1, 1.0f, cos1 },
+                    { sin0, 1.0f, cos0 }, { sin0, 0.0f, cos0 }, { sin1, 1.0f, cos1 }
+                };
+
+                memcpy(v, side, sizeof(side));
+                v += 6*3;
+            }
+
+            // Cap
+            for (int i = 0; i < 360; i += 360/slices)
+            {
+                const float cap[3][3] = {
+                    { 0.0f, 1.0f, 0.0f },
+                    { sinf(DEG2RAD*i), 1.0f, cosf(DEG2RAD*i) },
+                    { sinf(DEG2RAD*(i + 360.0f/slices)), 1.0f, cosf(DEG2RAD*(i + 360.0f/slices)) }
+                };
+
+                memcpy(v, cap, sizeof(cap));
+                v += 3*3;
+            }
+        }
+        else
+        {
+            // Cone
+            for (int i = 0; i < 360; i += 360/slices)
+            {
+                const float cone[3][3] = {
+                    { 0.0f, 1.0f, 0.0f },
+                    { sinf(DEG2RAD*i), 0.0f, cosf(DEG2RAD*i) },
+                    { sinf(DEG2RAD*(i + 360.0f/slices)), 0.0f, cosf(DEG2RAD*(i + 360.0f/slices)) }
+                };
+
+                memcpy(v, cone, sizeof(cone));
+                v += 3*3;
+            }
+        }
+
+        // Base
+        for (int i = 0; i < 360; i += 360/slices)
+        {
+            const float base[3][3] = {
+                { 0.0f, 0.0f, 0.0f },
+                { sinf(DEG2RAD*(i + 360.0f/slices)), 0.0f, cosf(DEG2RAD*(i + 360.0f/slices)) },
+                { sinf(DEG2RAD*i), 0.0f, cosf(DEG2RAD*i) }
+            };
+
+            memcpy(v, base, sizeof(base));
+            v += 3*3;
+        }
+    }
+
+    return geometry;
+}
+
+// Draw template triangles scaled and placed at position
+// NOTE: Taper is added to X and Z scale proportionally to Y, to draw cylinders with a different top radius
+static void DrawGeometryTemplate(const float *vertices, int vertexCount, Vector3 position, Vector3 scale, float taper, Color color)
+{
+    rlBegin(RL_TRIANGLES);
+
+        for (int first = 0; first < vertexCount; first += GEOMETRY_SPAN_MAX_VERTICES)
+        {
+            int count = ((vertexCount - first) < GEOMETRY_SPAN_MAX_VERTICES)? (vertexCount - first) : GEOMETRY_SPAN_MAX_VERTICES;
+            rlVertexSpan span = rlReserveVertices(count);
+            if (span.count == 0) break;
+
+            const float *src = vertices + 3*first;
+            float *dst = span.vertices;
+
+            // NOTE: Loops kept branch-free so they can be vectorized
+            if (taper == 0.0f)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    dst[3*i] = src[3*i]*scale.x + position.x;
+                    dst[3*i + 1] = src[3*i + 1]*scale.y + position.y;
+                    dst[3*i + 2] = src[3*i + 2]*scale.z + position.z;
+                }
+            }
+            else
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    float y = src[3*i + 1];
+
+                    dst[3*i] = src[3*i]*(scale.x + taper*y) + position.x;
+                    dst[3*i + 1] = y*scale.y + position.y;
+                    dst[3*i + 2] = src[3*i + 2]*(scale.z + taper*y) + position.z;
+                }
+            }
+
+            memset(span.texcoords, 0, count*2*sizeof(float));
+
+            for (int i = 0; i < count; i++)
+            {
+                span.colors[4*i] = color.r;
+                span.colors[4*i + 1] = color.g;
+                span.colors[4*i + 2] = color.b;
+                span.colors[4*i + 3] = color.a;
+            }
+
+            rlCommitVertices(span);
+        }
+
+    rlEnd();
+}
+
+// Unload geometry templates cache
+// NOTE: Called on CloseWindow()
+void UnloadGeometryTemplates(void)
+{
+    for (int i = 0; i < MAX_GEOMETRY_TEMPLATES; i++)
+    {
+        RL_FREE(geometryTemplates[i].vertices);
+        geometryTemplates[i] = (GeometryTemplate){ 0 };
+    }
+
+    geometryTemplateNext = 0;
+}
+
+// Get mesh triangle vertices, in the same order GetRayCollisionMesh() tests them
+static void GetMeshTriangle(Mesh mesh, int index, Vector3 *a, Vector3 *b, Vector3 *c)
+{
+    Vector3 *vertdata = (Vector3 *)mesh.vertices;
+
+    if (mesh.indices)
+    {
+        *a = vertdata[mesh.indices[index*3 + 0]];
+        *b = vertdata[mesh.indices[index*3 + 1]];
+        *c = vertdata[mesh.indices[index*3 + 2]];
+    }
+    else
+    {
+        *a = vertdata[index*3 + 0];
+        *b = vertdata[index*3 + 1];
+        *c = vertdata[index*3 + 2];
+    }
+}
+
+// Get half the surface area of a box, enough to compare SAH costs
+static float GetBoxHalfArea(Vector3 min, Vector3 max)
+{
+    Vector3 size = Vector3Subtract(max, min);
+
+    return size.x*size.y + size.y*size.z + size.z*size.x;
+}
+
+// Get distance along a ray to a box, 0 if the ray starts inside it or FLT_MAX if not hit
+// NOTE: Inverse ray direction is expected, it is computed once per ray
+static float GetRayBoxDistance(Vector3 origin, Vector3 invDirection, Vector3 min, Vector3 max)
+{
+    float t1 = (min.x - origin.x)*invDirection.x;
+    float t2 = (max.x - origin.x)*invDirection.x;
+    float tmin = fminf(t1, t2);
+    float tmax = fmaxf(t1, t2);
+
+    t1 = (min.y - origin.y)*invDirection.y;
+    t2 = (max.y - origin.y)*invDirection.y;
+    tmin = fmaxf(tmin, fminf(t1, t2));
+    tmax = fminf(tmax, fmaxf(t1, t2));
+
+    t1 = (min.z - origin.z)*invDirection.z;
+    t2 = (max.z - origin.z)*invDirection.z;
+    tmin = fmaxf(tmin, fminf(t1, t2));
+    tmax = fminf(tmax, fmaxf(t1, t2));
+
+    if ((tmax < 0.0f) || (tmin > tmax)) return FLT_MAX;
+
+    return (tmin > 0.0f)? tmin : 0.0f;
+}
+
+// Get collision info between ray and mesh using its BVH
+// NOTE: Only the closest candidate triangle is transformed and tested again in world space,
+// so the result matches testing every transformed triangle
+static RayCollision GetRayCollisionMeshBVH(Ray ray, Mesh mesh, Matrix transform)
+{
+    RayCollision collision = { 0 };
+    rMeshBVH *bvh = mesh.bvh;
+
+    // Move the ray into mesh local space instead of transforming every triangle
+    // NOTE: Local direction is not normalized, so distances along it match the world ray
+    Matrix invTransform = MatrixInvert(transform);
+    Ray localRay = { 0 };
+    localRay.position = Vector3Transform(ray.position, invTransform);
+    localRay.direction = Vector3Subtract(Vector3Transform(Vector3Add(ray.position, ray.direction), invTransform), localRay.position);
+    Vector3 invDirection = { 1.0f/localRay.direction.x, 1.0f/localRay.direction.y, 1.0f/localRay.direction.z };
+
+    float closest = FLT_MAX;
+    int closestTriangle = -1;
+
+    // Nodes to visit and their entry distance, GenMeshBVH() limits the depth to fit them
+    int stack[MESH_BVH_STACK_SIZE] = { 0 };
+    float stackDistance[MESH_BVH_STACK_SIZE] = { 0 };
+    int stackSize = 0;
+
+    float rootDistance = GetRayBoxDistance(localRay.position, invDirection, bvh->nodes[0].min, bvh->nodes[0].max);
+    if (rootDistance < FLT_MAX)
+    {
+        stack[0] = 0;
+        stackDistance[0] = rootDistance;
+        stackSize = 1;
+    }
+
+    while (stackSize > 0)
+    {
+        stackSize--;
+        if (stackDistance[stackSize] >= closest) continue;   // Node is behind the closest hit
+
+        rMeshBVHNode *node = &bvh->nodes[stack[stackSize]];
+
+        if (node->count > 0)
+        {
+            for (int i = node->first; i < (node->first + node->count); i++)
+            {
+                Vector3 a, b, c;
+                GetMeshTriangle(mesh, bvh->triangles[i], &a, &b, &c);
+
+                RayCollision triHitInfo = GetRayCollisionTriangle(localRay, a, b, c);
+
+                if (triHitInfo.hit && (triHitInfo.distance < closest))
+                {
+                    closest = triHitInfo.distance;
+                    closestTriangle = bvh->triangles[i];
+                }
+            }
+        }
+        else
+        {
+            int nearChild = node->first;
+            int farChild = node->first + 1;
+            float nearDistance = GetRayBoxDistance(localRay.position, invDirection, bvh->nodes[nearChild].min, bvh->nodes[nearChild].max);
+            float farDistance = GetRayBoxDistance(localRay.position, invDirection, bvh->nodes[farChild].min, bvh->nodes[farChild].max);
+
+            if (farDistance < nearDistance)
+            {
+                int tmp = nearChild; nearChild = farChild; farChild = tmp;
+                float tmpDistance = nearDistance; nearDistance = farDistance; farDistance = tmpDistance;
+            }
+
+            // Push the far child first so the near one is visited first
+            if (farDistance < closest)
+            {
+                stack[stackSize] = farChild;
+                stackDistance[stackSize] = farDistance;
+                stackSize++;
+            }
+
+            if (nearDistance < closest)
+            {
+                stack[stackSize] = nearChild;
+                stackDistance[stackSize] = nearDistance;
+                stackSize++;
+            }
+        }
+    }
+
+    if (closestTriangle >= 0)
+    {
+        Vector3 a, b, c;
+        GetMeshTriangle(mesh, closestTriangle, &a, &b, &c);
+
+        a = Vector3Transform(a, transform);
+        b = Vector3Transform(b, transform);
+        c = Vector3Transform(c, transform);
+
+        collision = GetRayCollisionTriangle(ray, a, b, c);
+    }
+
+    return collision;
+}
+
 #if defined(SUPPORT_FILEFORMAT_IQM) || defined(SUPPORT_FILEFORMAT_GLTF)
 // Build pose from parent joints
 // NOTE: Required for animations loading (required by IQM and GLTF)
@@ -70,6 +70,9 @@
 #ifndef SPLINE_SEGMENT_DIVISIONS
     #define SPLINE_SEGMENT_DIVISIONS      24      // Spline segment divisions
 #endif
+#ifndef SHAPES_SPAN_MAX_QUADS
+    #define SHAPES_SPAN_MAX_QUADS        256      // Maximum quads reserved in the render batch at once
+#endif
 
 
 //----------------------------------------------------------------------------------
@@ -87,6 +90,7 @@ Rectangle texShapesRec = { 0.0f, 0.0f, 1.0f, 1.0f };    // Texture source rectan
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
 static float EaseCubicInOut(float t, float b, float c, float d);    // Cubic easing
+static void SetShapesVertexData(rlVertexSpan span, const unsigned char *corners, Color color);  // Write shapes texcoords and color to reserved quads
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -304,42 +308,55 @@ void DrawCircleSector(Vector2 center, float radius, float startAngle, float endA
 
     rlBegin(RL_QUADS);
 
-        // NOTE: Every QUAD actually represents two segments
-        for (int i = 0; i < segments/2; i++)
-        {
-            rlColor4ub(color.r, color.g, color.b, color.a);
+        // NOTE: Every QUAD actually represents two segments, in case number of segments
+        // is odd, we add one last piece to the cake
+        int quads = segments/2 + segments%2;
+        int sectorQuads = segments/2;
 
-            rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
-            rlVertex2f(center.x, center.y);
+        // NOTE: Quads are reserved in pieces that fit a render batch
+        for (int first = 0; first < quads; first += SHAPES_SPAN_MAX_QUADS)
+        {
+            int count = ((quads - first) < SHAPES_SPAN_MAX_QUADS)? (quads - first) : SHAPES_SPAN_MAX_QUADS;
+            rlVertexSpan span = rlReserveVertices(4*count);
+            if (span.count == 0) break;
 
-            rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-            rlVertex2f(center.x + cosf(DEG2RAD*(angle + stepLength*2.0f))*radius, center.y + sinf(DEG2RAD*(angle + stepLength*2.0f))*radius);
+            SetShapesVertexData(span, (const unsigned char[4]){ 0, 3, 2, 1 }, color);
 
-            rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + cosf(DEG2RAD*(angle + stepLength))*radius, center.y + sinf(DEG2RAD*(angle + stepLength))*radius);
+            for (int i = 0; i < count; i++)
+            {
+                float *v = span.vertices + 12*i;
+                float c0 = cosf(DEG2RAD*angle), s0 = sinf(DEG2RAD*angle);
+                float c1 = cosf(DEG2RAD*(angle + stepLength)), s1 = sinf(DEG2RAD*(angle + stepLength));
 
-            rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + cosf(DEG2RAD*angle)*radius, center.y + sinf(DEG2RAD*angle)*radius);
+                v[0] = center.x; v[1] = center.y; v[2] = span.depth;
 
-            angle += (stepLength*2.0f);
-        }
+                if ((first + i) < sectorQuads)
+                {
+                    float c2 = cosf(DEG2RAD*(angle + stepLength*2.0f)), s2 = sinf(DEG2RAD*(angle + stepLength*2.0f));
 
-        // NOTE: In case number of segments is odd, we add one last piece to the cake
-        if ((segments%2) == 1)
-        {
-            rlColor4ub(color.r, color.g, color.b, color.a);
+                    v[3] = center.x + c2*radius; v[4] = center.y + s2*radius; v[5] = span.depth;
+                    v[6] = center.x + c1*radius; v[7] = center.y + s1*radius; v[8] = span.depth;
+                    v[9] = center.x + c0*radius; v[10] = center.y + s0*radius; v[11] = span.depth;
+                }
+                else
+                {
+                    float *uv = span.texcoords + 8*i;
 
-            rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
-            rlVertex2f(center.x, center.y);
+                    v[3] = center.x + c1*radius; v[4] = center.y + s1*radius; v[5] = span.depth;
+                    v[6] = center.x + c0*radius; v[7] = center.y + s0*radius; v[8] = span.depth;
+                    v[9] = center.x; v[10] = center.y; v[11] = span.depth;
 
-            rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + cosf(DEG2RAD*(angle + stepLength))*radius, center.y + sinf(DEG2RAD*(angle + stepLength))*radius);
+                    // Last piece vertices are ordered differently, swap texcoords accordingly
+                    float u = uv[2], w = uv[3];
+                    uv[2] = uv[4]; uv[3] = uv[5];
+                    uv[4] = uv[6]; uv[5] = uv[7];
+                    uv[6] = u; uv[7] = w;
+                }
 
-            rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + cosf(DEG2RAD*angle)*radius, center.y + sinf(DEG2RAD*angle)*radius);
+                angle += (stepLength*2.0f);
+            }
 
-            rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-            rlVertex2f(center.x, center.y);
+            rlCommitVertices(span);
         }
 
     rlEnd();
@@ -711,20 +728,20 @@ void DrawRectanglePro(Rectangle rec, Vector2 origin, float rotation, Color color
 
     rlBegin(RL_QUADS);
 
-        rlNormal3f(0.0f, 0.0f, 1.0f);
-        rlColor4ub(color.r, color.g, color.b, color.a);
-
-        rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
-        rlVertex2f(topLeft.x, topLeft.y);
+        rlVertexSpan span = rlReserveVertices(4);
 
-        rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-        rlVertex2f(bottomLeft.x, bottomLeft.y);
+        if (span.count > 0)
+        {
+            SetShapesVertexData(span, (const unsigned char[4]){ 0, 1, 2, 3 }, color);
 
-        rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-        rlVertex2f(bottomRight.x, bottomRight.y);
+            float *v = span.vertices;
+            v[0] = topLeft.x; v[1] = topLeft.y; v[2] = span.depth;
+            v[3] = bottomLeft.x; v[4] = bottomLeft.y; v[5] = span.depth;
+            v[6] = bottomRight.x; v[7] = bottomRight.y; v[8] = span.depth;
+            v[9] = topRight.x; v[10] = topRight.y; v[11] = span.depth;
 
-        rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-        rlVertex2f(topRight.x, topRight.y);
+            rlCommitVertices(span);
+        }
 
     rlEnd();
 
@@ -767,24 +784,32 @@ void DrawRectangleGradientEx(Rectangle rec, Color col1, Color col2, Color col3,
     rlSetTexture(texShapes.id);
 
     rlBegin(RL_QUADS);
-        rlNormal3f(0.0f, 0.0f, 1.0f);
 
-        // NOTE: Default raylib font character 95 is a white square
-        rlColor4ub(col1.r, col1.g, col1.b, col1.a);
-        rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
-        rlVertex2f(rec.x, rec.y);
+        rlVertexSpan span = rlReserveVertices(4);
 
-        rlColor4ub(col2.r, col2.g, col2.b, col2.a);
-        rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-        rlVertex2f(rec.x, rec.y + rec.height);
+        if (span.count > 0)
+        {
+            // NOTE: Default raylib font character 95 is a white square
+            SetShapesVertexData(span, (const unsigned char[4]){ 0, 1, 2, 3 }, col1);
 
-        rlColor4ub(col3.r, col3.g, col3.b, col3.a);
-        rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-        rlVertex2f(rec.x + rec.width, rec.y + rec.height);
+            const Color corners[4] = { col1, col2, col3, col4 };
+            for (int i = 1; i < 4; i++)
+            {
+                span.colors[4*i] = corners[i].r;
+                span.colors[4*i + 1] = corners[i].g;
+                span.colors[4*i + 2] = corners[i].b;
+                span.colors[4*i + 3] = corners[i].a;
+            }
+
+            float *v = span.vertices;
+            v[0] = rec.x; v[1] = rec.y; v[2] = span.depth;
+            v[3] = rec.x; v[4] = rec.y + rec.height; v[5] = span.depth;
+            v[6] = rec.x + rec.width; v[7] = rec.y + rec.height; v[8] = span.depth;
+            v[9] = rec.x + rec.width; v[10] = rec.y; v[11] = span.depth;
+
+            rlCommitVertices(span);
+        }
 
-        rlColor4ub(col4.r, col4.g, col4.b, col4.a);
-        rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-        rlVertex2f(rec.x + rec.width, rec.y);
     rlEnd();
 
     rlSetTexture(0);
@@ -1317,19 +1342,22 @@ void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color)
     rlSetTexture(texShapes.id);
 
     rlBegin(RL_QUADS);
-        rlColor4ub(color.r, color.g, color.b, color.a);
 
-        rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
-        rlVertex2f(v1.x, v1.y);
+        rlVertexSpan span = rlReserveVertices(4);
 
-        rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-        rlVertex2f(v2.x, v2.y);
+        if (span.count > 0)
+        {
+            SetShapesVertexData(span, (const unsigned char[4]){ 0, 1, 2, 3 }, color);
 
-        rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-        rlVertex2f(v2.x, v2.y);
+            float *v = span.vertices;
+            v[0] = v1.x; v[1] = v1.y; v[2] = span.depth;
+            v[3] = v2.x; v[4] = v2.y; v[5] = span.depth;
+            v[6] = v2.x; v[7] = v2.y; v[8] = span.depth;
+            v[9] = v3.x; v[10] = v3.y; v[11] = span.depth;
+
+            rlCommitVertices(span);
+        }
 
-        rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-        rlVertex2f(v3.x, v3.y);
     rlEnd();
 
     rlSetTexture(0);
@@ -1429,25 +1457,33 @@ void DrawPoly(Vector2 center, int sides, float radius, float rotation, Color col
     rlSetTexture(texShapes.id);
 
     rlBegin(RL_QUADS);
-        for (int i = 0; i < sides; i++)
+
+        // NOTE: Quads are reserved in pieces that fit a render batch
+        for (int first = 0; first < sides; first += SHAPES_SPAN_MAX_QUADS)
         {
-            rlColor4ub(color.r, color.g, color.b, color.a);
-            float nextAngle = centralAngle + angleStep;
+            int count = ((sides - first) < SHAPES_SPAN_MAX_QUADS)? (sides - first) : SHAPES_SPAN_MAX_QUADS;
+            rlVertexSpan span = rlReserveVertices(4*count);
+            if (span.count == 0) break;
 
-            rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
-            rlVertex2f(center.x, center.y);
+            SetShapesVertexData(span, (const unsigned char[4]){ 0, 1, 3, 2 }, color);
 
-            rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + cosf(centralAngle)*radius, center.y + sinf(centralAngle)*radius);
+            for (int i = 0; i < count; i++)
+            {
+                float *v = span.vertices + 12*i;
+                float nextAngle = centralAngle + angleStep;
+                float x0 = center.x + cosf(centralAngle)*radius, y0 = center.y + sinf(centralAngle)*radius;
 
-            rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-            rlVertex2f(center.x + cosf(nextAngle)*radius, center.y + sinf(nextAngle)*radius);
+                v[0] = center.x; v[1] = center.y; v[2] = span.depth;
+                v[3] = x0; v[4] = y0; v[5] = span.depth;
+                v[6] = center.x + cosf(nextAngle)*radius; v[7] = center.y + sinf(nextAngle)*radius; v[8] = span.depth;
+                v[9] = x0; v[10] = y0; v[11] = span.depth;
 
-            rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + cosf(centralAngle)*radius, center.y + sinf(centralAngle)*radius);
+                centralAngle = nextAngle;
+            }
 
-            centralAngle = nextAngle;
+            rlCommitVertices(span);
         }
+
     rlEnd();
     rlSetTexture(0);
 #else
@@ -2241,4 +2277,30 @@ static float EaseCubicInOut(float t, float b, float c, float d)
     return 0.5f*c*(t*t*t + 2.0f) + b;
 }
 
+// Write shapes texture coordinates and color to quads reserved with rlReserveVertices()
+// NOTE: Corners give the order of every quad vertex in the shapes texture rectangle:
+// 0 top-left, 1 bottom-left, 2 bottom-right, 3 top-right
+static void SetShapesVertexData(rlVertexSpan span, const unsigned char *corners, Color color)
+{
+    float left = texShapesRec.x/texShapes.width;
+    float top = texShapesRec.y/texShapes.height;
+    float right = (texShapesRec.x + texShapesRec.width)/texShapes.width;
+    float bottom = (texShapesRec.y + texShapesRec.height)/texShapes.height;
+    const float texcoords[4][2] = { { left, top }, { left, bottom }, { right, bottom }, { right, top } };
+
+    for (int i = 0; i < span.count; i++)
+    {
+        const float *uv = texcoords[corners[i%4]];
+
+        span.texcoords[2*i] = uv[0];
+        span.texcoords[2*i + 1] = uv[1];
+
+        span.colors[4*i] = color.r;
+        span.colors[4*i + 1] = color.g;
+        span.colors[4*i + 2] = color.b;
+        span.colors[4*i + 3] = color.a;
+    }
+}
+
 #endif      // SUPPORT_MODULE_RSHAPES
+
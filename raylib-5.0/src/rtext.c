@@ -62,13 +62,20 @@
 #if defined(SUPPORT_MODULE_RTEXT)
 
 #include "utils.h"          // Required for: LoadFile*()
-#include "rlgl.h"           // OpenGL abstraction layer to OpenGL 1.1, 2.1, 3.3+ or ES2 -> Only DrawTextPro()
+#include "rlgl.h"           // OpenGL abstraction layer to OpenGL 1.1, 2.1, 3.3+ or ES2 -> DrawTextPro(), DrawGlyphQuad()
 
 #include <stdlib.h>         // Required for: malloc(), free()
 #include <stdio.h>          // Required for: vsprintf()
 #include <string.h>         // Required for: strcmp(), strstr(), strcpy(), strncpy() [Used in TextReplace()], sscanf() [Used in LoadBMFont()]
 #include <stdarg.h>         // Required for: va_list, va_start(), vsprintf(), va_end() [Used in TextFormat()]
 #include <ctype.h>          // Required for: toupper(), tolower() [Used in TextToUpper(), TextToLower()]
+#include <stdint.h>         // Required for: uint64_t [Used in GetTextAsciiLength()]
+
+// SIMD backend for ASCII runs scanning, see GetTextAsciiLength()
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>      // Required for: SSE2 intrinsics
+    #define RTEXT_SIMD_SSE
+#endif
 
 #if defined(SUPPORT_FILEFORMAT_TTF)
     #if defined(__GNUC__) // GCC and Clang
@@ -101,11 +108,42 @@
 #ifndef MAX_TEXTSPLIT_COUNT
     #define MAX_TEXTSPLIT_COUNT                  128        // Maximum number of substrings to split: TextSplit()
 #endif
+#ifndef FONT_GLYPH_LOOKUP_DIRECT
+    #define FONT_GLYPH_LOOKUP_DIRECT             256        // Codepoints mapped directly on font glyphs lookup table (ASCII/Latin-1), others are hashed
+#endif
+
+// Font glyphs lookup table layout (font.glyphLookup), built on font loading:
+//  - [0..FONT_GLYPH_LOOKUP_DIRECT-1]: Glyph index for every direct codepoint, missing ones already resolved to fallback
+//  - [FONT_GLYPH_LOOKUP_DIRECT]: Fallback glyph index ('?' or first glyph)
+//  - [FONT_GLYPH_LOOKUP_DIRECT + 1]: Hash slots mask (slots count - 1, slots count is a power of 2)
+//  - [FONT_GLYPH_LOOKUP_DIRECT + 2..]: Hash slots (codepoint, index) pairs, open addressing with linear probing, -1 codepoint on empty slots
+#define GLYPH_LOOKUP_FALLBACK       (FONT_GLYPH_LOOKUP_DIRECT)
+#define GLYPH_LOOKUP_MASK           (FONT_GLYPH_LOOKUP_DIRECT + 1)
+#define GLYPH_LOOKUP_SLOTS          (FONT_GLYPH_LOOKUP_DIRECT + 2)
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// ...
+#if defined(SUPPORT_FILEFORMAT_TTF)
+// Font glyphs rasterization job, see LoadFontData()
+typedef struct FontGlyphsJob {
+    const stbtt_fontinfo *fontInfo;     // Font info for data reading (read-only)
+    const int *codepoints;              // Codepoints to rasterize
+    GlyphInfo *glyphs;                  // Glyphs info data, one per codepoint
+    float scaleFactor;                  // Font scale factor for font size
+    int ascent;                         // Font ascent (baseline), unscaled
+    int fontSize;                       // Font size in pixels
+    int type;                           // Font type: FONT_DEFAULT, FONT_BITMAP, FONT_SDF
+} FontGlyphsJob;
+
+// Skyline node for font atlas packing, see GenImageFontAtlas()
+// NOTE: Nodes span the atlas width left to right, y is the bottom of the space used over the node
+typedef struct SkylineNode {
+    int x;                              // Node left edge
+    int y;                              // Used space bottom edge
+    int width;                          // Node width
+} SkylineNode;
+#endif
 
 //----------------------------------------------------------------------------------
 // Global variables
@@ -128,6 +166,14 @@ static Font defaultFont = { 0 };
 static Font LoadBMFont(const char *fileName);   // Load a BMFont file (AngelCode font file)
 #endif
 static int textLineSpacing = 15;                // Text vertical line spacing in pixels
+static void DrawGlyphQuad(Font font, int index, Vector2 position, float scaleFactor, Color tint);  // Submit glyph quad to current draw
+static unsigned int GetGlyphLookupHash(int codepoint);  // Get glyphs lookup table hash for a codepoint
+static int GetTextAsciiLength(const char *text, int size);  // Get length of the ASCII run at text start
+#if defined(SUPPORT_FILEFORMAT_TTF)
+static void LoadFontGlyphs(void *userData, int begin, int end);   // Rasterize glyphs [begin, end) of a font glyphs job
+static void PackFontAtlasSkyline(const GlyphInfo *glyphs, int glyphCount, int padding, bool npot, Rectangle *recs, int *width, int *height);  // Pack glyphs in the smallest atlas found
+static int PackGlyphsSkyline(const GlyphInfo *glyphs, const int *order, int glyphCount, int padding, int width, SkylineNode *nodes, Rectangle *recs);  // Pack glyphs on a skyline of given width
+#endif
 
 #if defined(SUPPORT_DEFAULT_FONT)
 extern void LoadFontDefault(void);
@@ -283,6 +329,7 @@ extern void LoadFontDefault(void)
     UnloadImage(imFont);
 
     defaultFont.baseSize = (int)defaultFont.recs[0].height;
+    defaultFont.glyphLookup = LoadFontGlyphLookup(defaultFont.glyphs, defaultFont.glyphCount);
 
     TRACELOG(LOG_INFO, "FONT: Default font loaded successfully (%i glyphs)", defaultFont.glyphCount);
 }
@@ -294,6 +341,8 @@ extern void UnloadFontDefault(void)
     UnloadTexture(defaultFont.texture);
     RL_FREE(defaultFont.glyphs);
     RL_FREE(defaultFont.recs);
+    RL_FREE(defaultFont.glyphLookup);
+    defaultFont.glyphLookup = NULL;
 }
 #endif      // SUPPORT_DEFAULT_FONT
 
@@ -499,6 +548,7 @@ Font LoadFontFromImage(Image image, Color key, int firstChar)
     UnloadImage(fontClear);     // Unload processed image once converted to texture
 
     font.baseSize = (int)font.recs[0].height;
+    font.glyphLookup = LoadFontGlyphLookup(font.glyphs, font.glyphCount);
 
     return font;
 }
@@ -524,7 +574,7 @@ Font LoadFontFromMemory(const char *fileType, const unsigned char *fileData, int
         {
             font.glyphPadding = FONT_TTF_DEFAULT_CHARS_PADDING;
 
-            Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font.baseSize, font.glyphPadding, 0);
+            Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font.baseSize, font.glyphPadding, 2);
             font.texture = LoadTextureFromImage(atlas);
 
             // Update glyphs[i].image to use alpha, required to be used on ImageDrawText()
@@ -536,6 +586,8 @@ Font LoadFontFromMemory(const char *fileType, const unsigned char *fileData, int
 
             UnloadImage(atlas);
 
+            font.glyphLookup = LoadFontGlyphLookup(font.glyphs, font.glyphCount);
+
             TRACELOG(LOG_INFO, "FONT: Data loaded successfully (%i pixel size | %i glyphs)", font.baseSize, font.glyphCount);
         }
         else font = GetFontDefault();
@@ -614,67 +666,19 @@ GlyphInfo *LoadFontData(const unsigned char *fileData, int dataSize, int fontSiz
 
             chars = (GlyphInfo *)RL_MALLOC(codepointCount*sizeof(GlyphInfo));
 
-            // NOTE: Using simple packaging, one char after another
-            for (int i = 0; i < codepointCount; i++)
-            {
-                int chw = 0, chh = 0;   // Character width and height (on generation)
-                int ch = codepoints[i];  // Character value to get info for
-                chars[i].value = ch;
-
-                //  Render a unicode codepoint to a bitmap
-                //      stbtt_GetCodepointBitmap()           -- allocates and returns a bitmap
-                //      stbtt_GetCodepointBitmapBox()        -- how big the bitmap must be
-                //      stbtt_MakeCodepointBitmap()          -- renders into bitmap you provide
-
-                if (type != FONT_SDF) chars[i].image.data = stbtt_GetCodepointBitmap(&fontInfo, scaleFactor, scaleFactor, ch, &chw, &chh, &chars[i].offsetX, &chars[i].offsetY);
-                else if (ch != 32) chars[i].image.data = stbtt_GetCodepointSDF(&fontInfo, scaleFactor, ch, FONT_SDF_CHAR_PADDING, FONT_SDF_ON_EDGE_VALUE, FONT_SDF_PIXEL_DIST_SCALE, &chw, &chh, &chars[i].offsetX, &chars[i].offsetY);
-                else chars[i].image.data = NULL;
-
-                stbtt_GetCodepointHMetrics(&fontInfo, ch, &chars[i].advanceX, NULL);
-                chars[i].advanceX = (int)((float)chars[i].advanceX*scaleFactor);
-
-                // Load characters images
-                chars[i].image.width = chw;
-                chars[i].image.height = chh;
-                chars[i].image.mipmaps = 1;
-                chars[i].image.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
-
-                chars[i].offsetY += (int)((float)ascent*scaleFactor);
-
-                // NOTE: We create an empty image for space character, it could be further required for atlas packing
-                if (ch == 32)
-                {
-                    Image imSpace = {
-                        .data = RL_CALLOC(chars[i].advanceX*fontSize, 2),
-                        .width = chars[i].advanceX,
-                        .height = fontSize,
-                        .mipmaps = 1,
-                        .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE
-                    };
-
-                    chars[i].image = imSpace;
-                }
-
-                if (type == FONT_BITMAP)
-                {
-                    // Aliased bitmap (black & white) font generation, avoiding anti-aliasing
-                    // NOTE: For optimum results, bitmap font should be generated at base pixel size
-                    for (int p = 0; p < chw*chh; p++)
-                    {
-                        if (((unsigned char *)chars[i].image.data)[p] < FONT_BITMAP_ALPHA_THRESHOLD) ((unsigned char *)chars[i].image.data)[p] = 0;
-                        else ((unsigned char *)chars[i].image.data)[p] = 255;
-                    }
-                }
-
-                // Get bounding box for character (maybe offset to account for chars that dip above or below the line)
-                /*
-                int chX1, chY1, chX2, chY2;
-                stbtt_GetCodepointBitmapBox(&fontInfo, ch, scaleFactor, scaleFactor, &chX1, &chY1, &chX2, &chY2);
-
-                TRACELOGD("FONT: Character box measures: %i, %i, %i, %i", chX1, chY1, chX2 - chX1, chY2 - chY1);
-                TRACELOGD("FONT: Character offsetY: %i", (int)((float)ascent*scaleFactor) + chY1);
-                */
-            }
+            // Rasterize glyphs, spread over threads if a parallel for callback is set
+            // NOTE: Every glyph is generated on its own, the result is the same as a sequential generation
+            FontGlyphsJob job = {
+                .fontInfo = &fontInfo,
+                .codepoints = codepoints,
+                .glyphs = chars,
+                .scaleFactor = scaleFactor,
+                .ascent = ascent,
+                .fontSize = fontSize,
+                .type = type
+            };
+
+            ParallelFor(LoadFontGlyphs, &job, codepointCount);
         }
         else TRACELOG(LOG_WARNING, "FONT: Failed to process TTF font data");
 
@@ -686,7 +690,8 @@ GlyphInfo *LoadFontData(const unsigned char *fileData, int dataSize, int fontSiz
 }
 
 // Generate image font atlas using chars info
-// NOTE: Packing method: 0-Default, 1-Skyline
+// NOTE: Packing method: 0-Default, 1-Skyline (stb_rect_pack),
+// 2-Skyline bottom-left with tight POT atlas size, 3-Skyline bottom-left with tight NPOT atlas size
 #if defined(SUPPORT_FILEFORMAT_TTF)
 Image GenImageFontAtlas(const GlyphInfo *glyphs, Rectangle **glyphRecs, int glyphCount, int fontSize, int padding, int packMethod)
 {
@@ -748,6 +753,9 @@ Image GenImageFontAtlas(const GlyphInfo *glyphs, Rectangle **glyphRecs, int glyp
     }
 #endif
 
+    // Skyline bottom-left packing sizes the atlas on its own, all glyphs always fit
+    if ((packMethod == 2) || (packMethod == 3)) PackFontAtlasSkyline(glyphs, glyphCount, padding, (packMethod == 3), recs, &atlas.width, &atlas.height);
+
     atlas.data = (unsigned char *)RL_CALLOC(1, atlas.width*atlas.height);   // Create a bitmap to store characters (8 bpp)
     atlas.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
     atlas.mipmaps = 1;
@@ -852,6 +860,17 @@ Image GenImageFontAtlas(const GlyphInfo *glyphs, Rectangle **glyphRecs, int glyp
         RL_FREE(nodes);
         RL_FREE(context);
     }
+    else if ((packMethod == 2) || (packMethod == 3))    // Skyline bottom-left, already packed
+    {
+        for (int i = 0; i < glyphCount; i++)
+        {
+            for (int y = 0; y < glyphs[i].image.height; y++)
+            {
+                memcpy((unsigned char *)atlas.data + ((int)recs[i].y + y)*atlas.width + (int)recs[i].x,
+                    (unsigned char *)glyphs[i].image.data + y*glyphs[i].image.width, glyphs[i].image.width);
+            }
+        }
+    }
 
 #if defined(SUPPORT_FONT_ATLAS_WHITE_REC)
     // Add a 3x3 white rectangle at the bottom-right corner of the generated atlas,
@@ -885,6 +904,55 @@ Image GenImageFontAtlas(const GlyphInfo *glyphs, Rectangle **glyphRecs, int glyp
 }
 #endif
 
+// Load font glyphs lookup table (codepoint -> index), see layout on defines
+// NOTE: Fonts loaded by raylib already have one, it is freed by UnloadFont()
+// NOTE: Lookups match the linear search over glyphs: first glyph for repeated codepoints,
+// last '?' glyph (or first glyph) for missing ones
+int *LoadFontGlyphLookup(const GlyphInfo *glyphs, int glyphCount)
+{
+    if ((glyphs == NULL) || (glyphCount <= 0)) return NULL;
+
+    int fallbackIndex = 0;
+    int hashedCount = 0;
+
+    for (int i = 0; i < glyphCount; i++)
+    {
+        if (glyphs[i].value == 63) fallbackIndex = i;
+        if (glyphs[i].value >= FONT_GLYPH_LOOKUP_DIRECT) hashedCount++;
+    }
+
+    // Keep hash load factor under 0.5, probing always ends on an empty slot
+    int slotCount = 1;
+    while (slotCount < 2*hashedCount) slotCount *= 2;
+
+    int *lookup = (int *)RL_MALLOC((GLYPH_LOOKUP_SLOTS + 2*slotCount)*sizeof(int));
+    int *slots = lookup + GLYPH_LOOKUP_SLOTS;
+
+    for (int i = 0; i < FONT_GLYPH_LOOKUP_DIRECT; i++) lookup[i] = fallbackIndex;
+    lookup[GLYPH_LOOKUP_FALLBACK] = fallbackIndex;
+    lookup[GLYPH_LOOKUP_MASK] = slotCount - 1;
+    for (int i = 0; i < slotCount; i++) slots[2*i] = -1;
+
+    // Filled backwards so the first glyph of a repeated codepoint is the one kept
+    for (int i = glyphCount - 1; i >= 0; i--)
+    {
+        int codepoint = glyphs[i].value;
+
+        if (codepoint < 0) continue;
+        else if (codepoint < FONT_GLYPH_LOOKUP_DIRECT) lookup[codepoint] = i;
+        else
+        {
+            unsigned int slot = GetGlyphLookupHash(codepoint)&(unsigned int)(slotCount - 1);
+            while ((slots[2*slot] != -1) && (slots[2*slot] != codepoint)) slot = (slot + 1)&(unsigned int)(slotCount - 1);
+
+            slots[2*slot] = codepoint;
+            slots[2*slot + 1] = i;
+        }
+    }
+
+    return lookup;
+}
+
 // Unload font glyphs info data (RAM)
 void UnloadFontData(GlyphInfo *glyphs, int glyphCount)
 {
@@ -905,6 +973,7 @@ void UnloadFont(Font font)
         UnloadFontData(font.glyphs, font.glyphCount);
         UnloadTexture(font.texture);
         RL_FREE(font.recs);
+        RL_FREE(font.glyphLookup);
 
         TRACELOGD("FONT: Unloaded font data from RAM and VRAM");
     }
@@ -1109,12 +1178,32 @@ void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, f
 
     float scaleFactor = fontSize/font.baseSize;         // Character quad scaling factor
 
+    // NOTE: All glyphs share the font texture, quads are submitted to a single draw
+    rlSetTexture(font.texture.id);
+    rlBegin(RL_QUADS);
+
+    int asciiEnd = 0;               // End of current ASCII run, its bytes are codepoints
+
     for (int i = 0; i < size;)
     {
         // Get next codepoint from byte string and glyph index in font
-        int codepointByteCount = 0;
-        int codepoint = GetCodepointNext(&text[i], &codepointByteCount);
-        int index = GetGlyphIndex(font, codepoint);
+        // NOTE: ASCII runs are found several bytes at a time and skip UTF-8 decoding
+        int codepointByteCount = 1;
+        int codepoint = 0;
+        int index = 0;
+
+        if ((i >= asciiEnd) && ((unsigned char)text[i] < 0x80)) asciiEnd = i + GetTextAsciiLength(&text[i], size - i);
+
+        if (i < asciiEnd)
+        {
+            codepoint = text[i];
+            index = (font.glyphLookup != NULL)? font.glyphLookup[codepoint] : GetGlyphIndex(font, codepoint);
+        }
+        else
+        {
+            codepoint = GetCodepointNext(&text[i], &codepointByteCount);
+            index = GetGlyphIndex(font, codepoint);
+        }
 
         if (codepoint == '\n')
         {
@@ -1126,7 +1215,7 @@ void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, f
         {
             if ((codepoint != ' ') && (codepoint != '\t'))
             {
-                DrawTextCodepoint(font, codepoint, (Vector2){ position.x + textOffsetX, position.y + textOffsetY }, fontSize, tint);
+                DrawGlyphQuad(font, index, (Vector2){ position.x + textOffsetX, position.y + textOffsetY }, scaleFactor, tint);
             }
 
             if (font.glyphs[index].advanceX == 0) textOffsetX += ((float)font.recs[index].width*scaleFactor + spacing);
@@ -1135,6 +1224,9 @@ void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, f
 
         i += codepointByteCount;   // Move text bytes counter to next codepoint
     }
+
+    rlEnd();
+    rlSetTexture(0);
 }
 
 // Draw text using Font and pro parameters (rotation)
@@ -1154,25 +1246,18 @@ void DrawTextPro(Font font, const char *text, Vector2 position, Vector2 origin,
 // Draw one character (codepoint)
 void DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSize, Color tint)
 {
+    if (font.texture.id == 0) return;
+
     // Character index position in sprite font
     // NOTE: In case a codepoint is not available in the font, index returned points to '?'
     int index = GetGlyphIndex(font, codepoint);
     float scaleFactor = fontSize/font.baseSize;     // Character quad scaling factor
 
-    // Character destination rectangle on screen
-    // NOTE: We consider glyphPadding on drawing
-    Rectangle dstRec = { position.x + font.glyphs[index].offsetX*scaleFactor - (float)font.glyphPadding*scaleFactor,
-                      position.y + font.glyphs[index].offsetY*scaleFactor - (float)font.glyphPadding*scaleFactor,
-                      (font.recs[index].width + 2.0f*font.glyphPadding)*scaleFactor,
-                      (font.recs[index].height + 2.0f*font.glyphPadding)*scaleFactor };
-
-    // Character source rectangle from font texture atlas
-    // NOTE: We consider chars padding when drawing, it could be required for outline/glow shader effects
-    Rectangle srcRec = { font.recs[index].x - (float)font.glyphPadding, font.recs[index].y - (float)font.glyphPadding,
-                         font.recs[index].width + 2.0f*font.glyphPadding, font.recs[index].height + 2.0f*font.glyphPadding };
-
-    // Draw the character texture on the screen
-    DrawTexturePro(font.texture, srcRec, dstRec, (Vector2){ 0, 0 }, 0.0f, tint);
+    rlSetTexture(font.texture.id);
+    rlBegin(RL_QUADS);
+        DrawGlyphQuad(font, index, position, scaleFactor, tint);
+    rlEnd();
+    rlSetTexture(0);
 }
 
 // Draw multiple character (codepoints)
@@ -1181,8 +1266,14 @@ void DrawTextCodepoints(Font font, const int *codepoints, int codepointCount, Ve
     int textOffsetY = 0;            // Offset between lines (on linebreak '\n')
     float textOffsetX = 0.0f;       // Offset X to next character to draw
 
+    if (font.texture.id == 0) return;
+
     float scaleFactor = fontSize/font.baseSize;         // Character quad scaling factor
 
+    // NOTE: All glyphs share the font texture, quads are submitted to a single draw
+    rlSetTexture(font.texture.id);
+    rlBegin(RL_QUADS);
+
     for (int i = 0; i < codepointCount; i++)
     {
         int index = GetGlyphIndex(font, codepoints[i]);
@@ -1197,13 +1288,16 @@ void DrawTextCodepoints(Font font, const int *codepoints, int codepointCount, Ve
         {
             if ((codepoints[i] != ' ') && (codepoints[i] != '\t'))
             {
-                DrawTextCodepoint(font, codepoints[i], (Vector2){ position.x + textOffsetX, position.y + textOffsetY }, fontSize, tint);
+                DrawGlyphQuad(font, index, (Vector2){ position.x + textOffsetX, position.y + textOffsetY }, scaleFactor, tint);
             }
 
             if (font.glyphs[index].advanceX == 0) textOffsetX += ((float)font.recs[index].width*scaleFactor + spacing);
             else textOffsetX += ((float)font.glyphs[index].advanceX*scaleFactor + spacing);
         }
     }
+
+    rlEnd();
+    rlSetTexture(0);
 }
 
 // Set vertical line spacing when drawing with line-breaks
@@ -1249,14 +1343,27 @@ Vector2 MeasureTextEx(Font font, const char *text, float fontSize, float spacing
 
     int letter = 0;                 // Current character
     int index = 0;                  // Index position in sprite font
+    int asciiEnd = 0;               // End of current ASCII run, its bytes are codepoints
 
     for (int i = 0; i < size;)
     {
         byteCounter++;
 
-        int next = 0;
-        letter = GetCodepointNext(&text[i], &next);
-        index = GetGlyphIndex(font, letter);
+        // NOTE: ASCII runs are found several bytes at a time and skip UTF-8 decoding
+        int next = 1;
+
+        if ((i >= asciiEnd) && ((unsigned char)text[i] < 0x80)) asciiEnd = i + GetTextAsciiLength(&text[i], size - i);
+
+        if (i < asciiEnd)
+        {
+            letter = text[i];
+            index = (font.glyphLookup != NULL)? font.glyphLookup[letter] : GetGlyphIndex(font, letter);
+        }
+        else
+        {
+            letter = GetCodepointNext(&text[i], &next);
+            index = GetGlyphIndex(font, letter);
+        }
 
         i += next;
 
@@ -1294,21 +1401,51 @@ int GetGlyphIndex(Font font, int codepoint)
 
 #define SUPPORT_UNORDERED_CHARSET
 #if defined(SUPPORT_UNORDERED_CHARSET)
-    int fallbackIndex = 0;      // Get index of fallback glyph '?'
-
-    // Look for character index in the unordered charset
-    for (int i = 0; i < font.glyphCount; i++)
+    if (font.glyphLookup != NULL)
     {
-        if (font.glyphs[i].value == 63) fallbackIndex = i;
+        // Constant time lookup: direct for ASCII/Latin-1, hashed for the rest
+        const int *lookup = font.glyphLookup;
 
-        if (font.glyphs[i].value == codepoint)
+        if ((codepoint >= 0) && (codepoint < FONT_GLYPH_LOOKUP_DIRECT)) index = lookup[codepoint];
+        else
         {
-            index = i;
-            break;
+            index = lookup[GLYPH_LOOKUP_FALLBACK];
+
+            if (codepoint >= 0)
+            {
+                const int *slots = lookup + GLYPH_LOOKUP_SLOTS;
+                unsigned int mask = (unsigned int)lookup[GLYPH_LOOKUP_MASK];
+
+                for (unsigned int slot = GetGlyphLookupHash(codepoint)&mask; slots[2*slot] != -1; slot = (slot + 1)&mask)
+                {
+                    if (slots[2*slot] == codepoint)
+                    {
+                        index = slots[2*slot + 1];
+                        break;
+                    }
+                }
+            }
         }
     }
+    else
+    {
+        // Font without lookup table (i.e. built by user code)
+        int fallbackIndex = 0;      // Get index of fallback glyph '?'
+
+        // Look for character index in the unordered charset
+        for (int i = 0; i < font.glyphCount; i++)
+        {
+            if (font.glyphs[i].value == 63) fallbackIndex = i;
+
+            if (font.glyphs[i].value == codepoint)
+            {
+                index = i;
+                break;
+            }
+        }
 
-    if ((index == 0) && (font.glyphs[0].value != codepoint)) index = fallbackIndex;
+        if ((index == 0) && (font.glyphs[0].value != codepoint)) index = fallbackIndex;
+    }
 #else
     index = codepoint - 32;
 #endif
@@ -1346,12 +1483,8 @@ unsigned int TextLength(const char *text)
 {
     unsigned int length = 0;
 
-    if (text != NULL)
-    {
-        // NOTE: Alternative: use strlen(text)
-
-        while (*text++) length++;
-    }
+    // NOTE: strlen() scans several bytes at a time
+    if (text != NULL) length = (unsigned int)strlen(text);
 
     return length;
 }
@@ -2001,6 +2134,347 @@ int GetCodepointPrevious(const char *text, int *codepointSize)
 //----------------------------------------------------------------------------------
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
+// Submit one glyph quad to the current draw
+// NOTE: Font texture must be set and RL_QUADS mode begun by the caller,
+// vertex order and texcoords match DrawTexturePro()
+static void DrawGlyphQuad(Font font, int index, Vector2 position, float scaleFactor, Color tint)
+{
+    rlVertexSpan span = rlReserveVertices(4);
+    if (span.count == 0) return;
+
+    // Character destination rectangle on screen
+    // NOTE: We consider glyphPadding on drawing
+    Rectangle dstRec = { position.x + font.glyphs[index].offsetX*scaleFactor - (float)font.glyphPadding*scaleFactor,
+                      position.y + font.glyphs[index].offsetY*scaleFactor - (float)font.glyphPadding*scaleFactor,
+                      (font.recs[index].width + 2.0f*font.glyphPadding)*scaleFactor,
+                      (font.recs[index].height + 2.0f*font.glyphPadding)*scaleFactor };
+
+    // Character source rectangle from font texture atlas
+    // NOTE: We consider chars padding when drawing, it could be required for outline/glow shader effects
+    Rectangle srcRec = { font.recs[index].x - (float)font.glyphPadding, font.recs[index].y - (float)font.glyphPadding,
+                         font.recs[index].width + 2.0f*font.glyphPadding, font.recs[index].height + 2.0f*font.glyphPadding };
+
+    float width = (float)font.texture.width;
+    float height = (float)font.texture.height;
+    float left = srcRec.x/width;
+    float top = srcRec.y/height;
+    float right = (srcRec.x + srcRec.width)/width;
+    float bottom = (srcRec.y + srcRec.height)/height;
+
+    // Top-left, bottom-left, bottom-right and top-right corners
+    float *v = span.vertices;
+    v[0] = dstRec.x; v[1] = dstRec.y; v[2] = span.depth;
+    v[3] = dstRec.x; v[4] = dstRec.y + dstRec.height; v[5] = span.depth;
+    v[6] = dstRec.x + dstRec.width; v[7] = dstRec.y + dstRec.height; v[8] = span.depth;
+    v[9] = dstRec.x + dstRec.width; v[10] = dstRec.y; v[11] = span.depth;
+
+    float *uv = span.texcoords;
+    uv[0] = left; uv[1] = top;
+    uv[2] = left; uv[3] = bottom;
+    uv[4] = right; uv[5] = bottom;
+    uv[6] = right; uv[7] = top;
+
+    for (int i = 0; i < 4; i++)
+    {
+        span.colors[4*i] = tint.r;
+        span.colors[4*i + 1] = tint.g;
+        span.colors[4*i + 2] = tint.b;
+        span.colors[4*i + 3] = tint.a;
+    }
+
+    rlCommitVertices(span);
+}
+
+// Get glyphs lookup table hash for a codepoint
+// NOTE: Multiplicative hashing, high bits folded into the low bits kept by the slots mask
+static unsigned int GetGlyphLookupHash(int codepoint)
+{
+    unsigned int hash = (unsigned int)codepoint*2654435761u;
+
+    return hash^(hash >> 16);
+}
+
+// Get length of the ASCII run at text start (bytes lower than 0x80), up to size bytes
+// NOTE: Scans 32 bytes at a time with SSE2, 8 bytes at a time otherwise, bytes are never read past size
+static int GetTextAsciiLength(const char *text, int size)
+{
+    int length = 0;
+
+    if ((size <= 0) || ((unsigned char)text[0] >= 0x80)) return 0;     // Multibyte text checks only one byte per codepoint
+
+#if defined(RTEXT_SIMD_SSE)
+    for (; length + 32 <= size; length += 32)
+    {
+        __m128i low = _mm_loadu_si128((const __m128i *)(text + length));
+        __m128i high = _mm_loadu_si128((const __m128i *)(text + length + 16));
+
+        if (_mm_movemask_epi8(_mm_or_si128(low, high)) != 0) break;
+    }
+    for (; length + 16 <= size; length += 16)
+    {
+        if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(text + length))) != 0) break;
+    }
+#endif
+    for (; length + 8 <= size; length += 8)
+    {
+        uint64_t chunk = 0;
+        memcpy(&chunk, text + length, 8);
+
+        if ((chunk & 0x8080808080808080ULL) != 0) break;
+    }
+    while ((length < size) && ((unsigned char)text[length] < 0x80)) length++;
+
+    return length;
+}
+
+#if defined(SUPPORT_FILEFORMAT_TTF)
+// Rasterize glyphs [begin, end) of a font glyphs job
+// NOTE: Called by ParallelFor() on any thread, only glyphs in range are written
+static void LoadFontGlyphs(void *userData, int begin, int end)
+{
+    FontGlyphsJob *job = (FontGlyphsJob *)userData;
+    GlyphInfo *glyphs = job->glyphs;
+
+    for (int i = begin; i < end; i++)
+    {
+        int chw = 0, chh = 0;   // Character width and height (on generation)
+        int ch = job->codepoints[i];  // Character value to get info for
+        glyphs[i].value = ch;
+
+        //  Render a unicode codepoint to a bitmap
+        //      stbtt_GetCodepointBitmap()           -- allocates and returns a bitmap
+        //      stbtt_GetCodepointBitmapBox()        -- how big the bitmap must be
+        //      stbtt_MakeCodepointBitmap()          -- renders into bitmap you provide
+
+        if (job->type != FONT_SDF) glyphs[i].image.data = stbtt_GetCodepointBitmap(job->fontInfo, job->scaleFactor, job->scaleFactor, ch, &chw, &chh, &glyphs[i].offsetX, &glyphs[i].offsetY);
+        else if (ch != 32) glyphs[i].image.data = stbtt_GetCodepointSDF(job->fontInfo, job->scaleFactor, ch, FONT_SDF_CHAR_PADDING, FONT_SDF_ON_EDGE_VALUE, FONT_SDF_PIXEL_DIST_SCALE, &chw, &chh, &glyphs[i].offsetX, &glyphs[i].offsetY);
+        else
+        {
+            // NOTE: SDF space is not generated, its offsets must still be set
+            glyphs[i].image.data = NULL;
+            glyphs[i].offsetX = 0;
+            glyphs[i].offsetY = 0;
+        }
+
+        stbtt_GetCodepointHMetrics(job->fontInfo, ch, &glyphs[i].advanceX, NULL);
+        glyphs[i].advanceX = (int)((float)glyphs[i].advanceX*job->scaleFactor);
+
+        // Load characters images
+        glyphs[i].image.width = chw;
+        glyphs[i].image.height = chh;
+        glyphs[i].image.mipmaps = 1;
+        glyphs[i].image.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+
+        glyphs[i].offsetY += (int)((float)job->ascent*job->scaleFactor);
+
+        // NOTE: We create an empty image for space character, it could be further required for atlas packing
+        if (ch == 32)
+        {
+            Image imSpace = {
+                .data = RL_CALLOC(glyphs[i].advanceX*job->fontSize, 2),
+                .width = glyphs[i].advanceX,
+                .height = job->fontSize,
+                .mipmaps = 1,
+                .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE
+            };
+
+            glyphs[i].image = imSpace;
+        }
+
+        if (job->type == FONT_BITMAP)
+        {
+            // Aliased bitmap (black & white) font generation, avoiding anti-aliasing
+            // NOTE: For optimum results, bitmap font should be generated at base pixel size
+            for (int p = 0; p < chw*chh; p++)
+            {
+                if (((unsigned char *)glyphs[i].image.data)[p] < FONT_BITMAP_ALPHA_THRESHOLD) ((unsigned char *)glyphs[i].image.data)[p] = 0;
+                else ((unsigned char *)glyphs[i].image.data)[p] = 255;
+            }
+        }
+
+        // Get bounding box for character (maybe offset to account for chars that dip above or below the line)
+        /*
+        int chX1, chY1, chX2, chY2;
+        stbtt_GetCodepointBitmapBox(job->fontInfo, ch, job->scaleFactor, job->scaleFactor, &chX1, &chY1, &chX2, &chY2);
+
+        TRACELOGD("FONT: Character box measures: %i, %i, %i, %i", chX1, chY1, chX2 - chX1, chY2 - chY1);
+        TRACELOGD("FONT: Character offsetY: %i", (int)((float)job->ascent*job->scaleFactor) + chY1);
+        */
+    }
+}
+#endif
+
+#if defined(SUPPORT_FILEFORMAT_TTF)
+// Compare glyphs packing keys, descending
+static int CompareGlyphPackKeys(const void *a, const void *b)
+{
+    long long ka = *(const long long *)a;
+    long long kb = *(const long long *)b;
+
+    return (ka < kb) - (ka > kb);
+}
+
+// Pack glyphs in the smallest atlas found, trying a few widths around the glyphs area square root
+// NOTE: Glyphs are packed tallest first, atlas sizes are powers of two or multiples of 4 (npot)
+static void PackFontAtlasSkyline(const GlyphInfo *glyphs, int glyphCount, int padding, bool npot, Rectangle *recs, int *width, int *height)
+{
+    int *order = (int *)RL_MALLOC(glyphCount*sizeof(int));
+    long long *keys = (long long *)RL_MALLOC(glyphCount*sizeof(long long));
+    SkylineNode *nodes = (SkylineNode *)RL_MALLOC((glyphCount + 1)*sizeof(SkylineNode));
+    Rectangle *packed = (Rectangle *)RL_MALLOC(glyphCount*sizeof(Rectangle));
+
+    // Sort by height then width, key keeps the index in the lower 20 bits (ascending on ties)
+    long long area = 0;
+    int maxWidth = 1;
+    for (int i = 0; i < glyphCount; i++)
+    {
+        int w = glyphs[i].image.width + 2*padding;
+        int h = glyphs[i].image.height + 2*padding;
+
+        area += (long long)w*h;
+        if (w > maxWidth) maxWidth = w;
+        keys[i] = ((long long)h << 40) | ((long long)w << 20) | (0xfffff - i);
+    }
+    qsort(keys, glyphCount, sizeof(long long), CompareGlyphPackKeys);
+    for (int i = 0; i < glyphCount; i++) order[i] = 0xfffff - (int)(keys[i] & 0xfffff);
+
+    // Candidate widths, the squarest atlas wins on same size
+    int side = (int)ceilf(sqrtf((float)area));
+    int candidates[4] = { 0 };
+    int candidateCount = 0;
+
+    if (npot)
+    {
+        candidates[candidateCount++] = side;
+        candidates[candidateCount++] = side*9/8;
+        candidates[candidateCount++] = side*5/4;
+        candidates[candidateCount++] = side*3/2;
+    }
+    else
+    {
+        int pot = 1;
+        while (pot < side) pot *= 2;
+        candidates[candidateCount++] = pot/2;
+        candidates[candidateCount++] = pot;
+        candidates[candidateCount++] = pot*2;
+    }
+
+    *width = 0;
+    *height = 0;
+    for (int c = 0; c < candidateCount; c++)
+    {
+        int w = (candidates[c] > maxWidth)? candidates[c] : maxWidth;
+        if (npot) w = (w + 3)/4*4;
+        else { int pot = 1; while (pot < w) pot *= 2; w = pot; }
+
+        int h = PackGlyphsSkyline(glyphs, order, glyphCount, padding, w, nodes, packed);
+        if (npot) h = (h + 3)/4*4;
+        else { int pot = 1; while (pot < h) pot *= 2; h = pot; }
+
+        long long size = (long long)w*h;
+        long long bestSize = (long long)(*width)*(*height);
+        int longSide = (w > h)? w : h;
+        int bestLongSide = (*width > *height)? *width : *height;
+
+        if ((*width == 0) || (size < bestSize) || ((size == bestSize) && (longSide < bestLongSide)))
+        {
+            *width = w;
+            *height = h;
+            memcpy(recs, packed, glyphCount*sizeof(Rectangle));
+        }
+    }
+
+    RL_FREE(packed);
+    RL_FREE(nodes);
+    RL_FREE(keys);
+    RL_FREE(order);
+}
+
+// Pack glyphs (plus padding) bottom-left on a skyline of given width, height is unbounded
+// NOTE: Width must fit the widest glyph, returns the atlas height required
+static int PackGlyphsSkyline(const GlyphInfo *glyphs, const int *order, int glyphCount, int padding, int width, SkylineNode *nodes, Rectangle *recs)
+{
+    int nodeCount = 1;
+    int height = 1;
+
+    nodes[0] = (SkylineNode){ 0, 0, width };
+
+    for (int n = 0; n < glyphCount; n++)
+    {
+        int i = order[n];
+        int w = glyphs[i].image.width + 2*padding;
+        int h = glyphs[i].image.height + 2*padding;
+
+        recs[i] = (Rectangle){ (float)padding, (float)padding, (float)glyphs[i].image.width, (float)glyphs[i].image.height };
+        if ((w == 0) || (h == 0)) continue;     // Nothing to sample, no space required
+
+        // Find the node placing the rectangle nearest the atlas top, narrowest node on ties
+        int best = -1;
+        int bestBottom = 0;
+        for (int k = 0; (k < nodeCount) && (nodes[k].x + w <= width); k++)
+        {
+            int y = 0;
+            for (int j = k, left = w; left > 0; left -= nodes[j].width, j++) if (nodes[j].y > y) y = nodes[j].y;
+
+            if ((best == -1) || (y + h < bestBottom) || ((y + h == bestBottom) && (nodes[k].width < nodes[best].width)))
+            {
+                best = k;
+                bestBottom = y + h;
+            }
+        }
+
+        int x = nodes[best].x;
+        recs[i].x = (float)(x + padding);
+        recs[i].y = (float)(bestBottom - h + padding);
+        if (bestBottom > height) height = bestBottom;
+
+        // Add the rectangle node, shrinking or removing the nodes below it
+        memmove(&nodes[best + 1], &nodes[best], (nodeCount - best)*sizeof(SkylineNode));
+        nodeCount++;
+        nodes[best] = (SkylineNode){ x, bestBottom, w };
+
+        for (int k = best + 1; (k < nodeCount) && (nodes[k].x < x + w);)
+        {
+            int shrink = x + w - nodes[k].x;
+
+            if (shrink < nodes[k].width)
+            {
+                nodes[k].x += shrink;
+                nodes[k].width -= shrink;
+                break;
+            }
+
+            memmove(&nodes[k], &nodes[k + 1], (nodeCount - k - 1)*sizeof(SkylineNode));
+            nodeCount--;
+        }
+
+        // Merge neighbour nodes at the same height
+        for (int k = 0; k < nodeCount - 1;)
+        {
+            if (nodes[k].y == nodes[k + 1].y)
+            {
+                nodes[k].width += nodes[k + 1].width;
+                memmove(&nodes[k + 1], &nodes[k + 2], (nodeCount - k - 2)*sizeof(SkylineNode));
+                nodeCount--;
+            }
+            else k++;
+        }
+    }
+
+#if defined(SUPPORT_FONT_ATLAS_WHITE_REC)
+    // Keep the bottom-right 3x3 white rectangle clear of glyphs
+    int cornerBottom = 0;
+    for (int k = 0; k < nodeCount; k++)
+    {
+        if ((nodes[k].x + nodes[k].width > width - 3) && (nodes[k].y > cornerBottom)) cornerBottom = nodes[k].y;
+    }
+    if (cornerBottom + 3 > height) height = cornerBottom + 3;
+#endif
+
+    return height;
+}
+#endif
+
 #if defined(SUPPORT_FILEFORMAT_FNT)
 // Read a line from memory
 // REQUIRES: memcpy()
@@ -2148,6 +2622,8 @@ static Font LoadBMFont(const char *fileName)
     UnloadImage(imFont);
     UnloadFileText(fileText);
 
+    font.glyphLookup = LoadFontGlyphLookup(font.glyphs, font.glyphCount);
+
     if (font.texture.id == 0)
     {
         UnloadFont(font);
@@ -66,6 +66,7 @@ static LoadFileDataCallback loadFileData = NULL;    // LoadFileData callback fun
 static SaveFileDataCallback saveFileData = NULL;    // SaveFileText callback function pointer
 static LoadFileTextCallback loadFileText = NULL;    // LoadFileText callback function pointer
 static SaveFileTextCallback saveFileText = NULL;    // SaveFileText callback function pointer
+static ParallelForCallback parallelFor = NULL;      // ParallelFor callback function pointer
 
 //----------------------------------------------------------------------------------
 // Functions to set internal callbacks
@@ -75,6 +76,17 @@ void SetLoadFileDataCallback(LoadFileDataCallback callback) { loadFileData = cal
 void SetSaveFileDataCallback(SaveFileDataCallback callback) { saveFileData = callback; }  // Set custom file data saver
 void SetLoadFileTextCallback(LoadFileTextCallback callback) { loadFileText = callback; }  // Set custom file text loader
 void SetSaveFileTextCallback(SaveFileTextCallback callback) { saveFileText = callback; }  // Set custom file text saver
+void SetParallelForCallback(ParallelForCallback callback) { parallelFor = callback; }     // Set custom parallel for
+
+// Run work over items [0, count), through the parallel for callback if set
+// NOTE: Work must only write per item data, results are the same on any threads split
+void ParallelFor(ParallelWorkCallback work, void *userData, int count)
+{
+    if (count <= 0) return;
+
+    if (parallelFor != NULL) parallelFor(work, userData, count);
+    else work(userData, 0, count);
+}
 
 
 #if defined(PLATFORM_ANDROID)
@@ -69,6 +69,8 @@
 extern "C" {            // Prevents name mangling of functions
 #endif
 
+void ParallelFor(ParallelWorkCallback work, void *userData, int count);  // Run work over items [0, count), through the parallel for callback if set
+
 #if defined(PLATFORM_ANDROID)
 void InitAssetManager(AAssetManager *manager, const char *dataPath);   // Initialize asset manager from android app
 FILE *android_fopen(const char *fileName, const char *mode);           // Replacement for fopen() -> Read-only!
@@ -0,0 +1,279 @@
+// RIGS
+// skinned models (glTF/IQM) used by animated targets
+// the simulation only poses one box per bone from the bone transforms,
+// the meshes are never skinned for it, only the renderer skins them
+// (see rig_skin)
+
+#define RIG_HITBOX_CAP 24
+// raylib samples glTF animations at ~60 fps and IQM frames carry no rate
+#define RIG_ANIM_FPS 60
+// bone ids are bytes
+#define RIG_BONE_CAP 256
+
+typedef struct {
+  Vector3 center;
+  // columns of the rotation
+  Vector3 axes[3];
+  Vector3 half;
+} obb_t;
+
+typedef struct {
+  int bone;
+  // in the bind space of the bone
+  Vector3 center;
+  Vector3 half;
+  bool head;
+} bone_box_t;
+
+typedef struct {
+  char *path;
+  Model model;
+  ModelAnimation *anims;
+  int anim_cnt;
+  bone_box_t boxes[RIG_HITBOX_CAP];
+  size_t box_cnt;
+  // of the bind pose, targets are centred on it and scaled to their height
+  BoundingBox bounds;
+} rig_t;
+
+struct {
+  rig_t *data;
+  size_t len;
+  size_t cap;
+} rigs;
+
+// returns the index of the rig at path, the same path is only loaded once
+size_t rig_register(sv path) {
+  for (size_t i = 0; i < rigs.len; ++i) {
+    if (strlen(rigs.data[i].path) == path.len &&
+	strncmp(rigs.data[i].path, path.data, path.len) == 0) {
+      return i;
+    }
+  }
+  if (rigs.len >= rigs.cap) {
+    if (rigs.cap == 0) { rigs.cap = 1; }
+    rigs.cap *= 2;
+    rigs.data = realloc(rigs.data, rigs.cap * sizeof(*rigs.data));
+    assert(rigs.data && "REALLOC FAILED");
+  }
+  rigs.data[rigs.len] = (rig_t) { .path = strndup(path.data, path.len) };
+  return rigs.len++;
+}
+
+bool bone_is_head(const char *name) {
+  char lower[32] = {};
+  for (size_t i = 0; i < sizeof(lower) - 1 && name[i]; ++i) {
+    lower[i] = (name[i] >= 'A' && name[i] <= 'Z') ? name[i] - 'A' + 'a' : name[i];
+  }
+  return strstr(lower, "head") != NULL;
+}
+
+// fits a box around the vertices each bone dominates, in the bone's
+// bind space, keeping the RIG_HITBOX_CAP bones with the most vertices
+void rig_build_boxes(rig_t *rig) {
+  Model *m = &rig->model;
+  int n = m->boneCount;
+  assert(n > 0 && m->bindPose && "RIG HAS NO SKELETON");
+  size_t *counts = calloc(n, sizeof(*counts));
+  Vector3 *lo = malloc(n * sizeof(*lo));
+  Vector3 *hi = malloc(n * sizeof(*hi));
+  Quaternion *inv = malloc(n * sizeof(*inv));
+  for (int b = 0; b < n; ++b) {
+    lo[b] = (Vector3) { INFINITY, INFINITY, INFINITY };
+    hi[b] = (Vector3) { -INFINITY, -INFINITY, -INFINITY };
+    inv[b] = QuaternionInvert(m->bindPose[b].rotation);
+  }
+
+  rig->bounds.min = (Vector3) { INFINITY, INFINITY, INFINITY };
+  rig->bounds.max = (Vector3) { -INFINITY, -INFINITY, -INFINITY };
+  for (int i = 0; i < m->meshCount; ++i) {
+    Mesh *mesh = &m->meshes[i];
+    if (!mesh->boneIds || !mesh->boneWeights) continue;
+    for (int v = 0; v < mesh->vertexCount; ++v) {
+      Vector3 p = { mesh->vertices[3*v], mesh->vertices[3*v + 1], mesh->vertices[3*v + 2] };
+      rig->bounds.min = Vector3Min(rig->bounds.min, p);
+      rig->bounds.max = Vector3Max(rig->bounds.max, p);
+      // dominant bone
+      int best = 0;
+      for (int k = 1; k < 4; ++k) {
+	if (mesh->boneWeights[4*v + k] > mesh->boneWeights[4*v + best]) best = k;
+      }
+      int b = mesh->boneIds[4*v + best];
+      if (b >= n) continue;
+      // same bind space as UpdateModelAnimation
+      Vector3 local = Vector3RotateByQuaternion(Vector3Subtract(p, m->bindPose[b].translation), inv[b]);
+      lo[b] = Vector3Min(lo[b], local);
+      hi[b] = Vector3Max(hi[b], local);
+      counts[b]++;
+    }
+  }
+
+  rig->box_cnt = 0;
+  for (;;) {
+    int best = -1;
+    for (int b = 0; b < n; ++b) {
+      if (counts[b] > 0 && (best < 0 || counts[b] > counts[best])) best = b;
+    }
+    if (best < 0 || rig->box_cnt == RIG_HITBOX_CAP) break;
+    rig->boxes[rig->box_cnt++] = (bone_box_t) {
+      .bone = best,
+      .center = Vector3Scale(Vector3Add(lo[best], hi[best]), 0.5f),
+      .half = Vector3Scale(Vector3Subtract(hi[best], lo[best]), 0.5f),
+      .head = bone_is_head(m->bones[best].name),
+    };
+    counts[best] = 0;
+  }
+  assert(rig->box_cnt > 0 && "RIG HAS NO SKINNED VERTICES");
+
+  free(counts);
+  free(lo);
+  free(hi);
+  free(inv);
+}
+
+// needs a window, the meshes are uploaded for drawing
+void load_rig(rig_t *rig) {
+  printf("Loading rig from %s...\n", rig->path);
+  rig->model = LoadModel(rig->path);
+  assert(IsModelReady(rig->model) && "Rig path specified is invalid or another model loading error has occurred");
+  rig->anims = LoadModelAnimations(rig->path, &rig->anim_cnt);
+  rig_build_boxes(rig);
+}
+
+void unload_rigs(void) {
+  for (size_t i = 0; i < rigs.len; ++i) {
+    rig_t *rig = &rigs.data[i];
+    if (rig->anims) UnloadModelAnimations(rig->anims, rig->anim_cnt);
+    UnloadModel(rig->model);
+    free(rig->path);
+  }
+  free(rigs.data);
+  rigs.data = NULL;
+  rigs.len = 0;
+  rigs.cap = 0;
+}
+
+// frames of anim either side of time (seconds into the animation) and
+// how far time is between them, the bind pose if there is no animation
+void rig_frames(const rig_t *rig, int anim, float time,
+		const Transform **p0, const Transform **p1, float *u) {
+  *p0 = rig->model.bindPose;
+  *p1 = rig->model.bindPose;
+  *u = 0;
+  if (anim < rig->anim_cnt && rig->anims[anim].frameCount > 0) {
+    const ModelAnimation *a = &rig->anims[anim];
+    float f = time * RIG_ANIM_FPS;
+    int f0 = (int)f % a->frameCount;
+    int f1 = (f0 + 1) % a->frameCount;
+    *u = f - floorf(f);
+    *p0 = a->framePoses[f0];
+    *p1 = a->framePoses[f1];
+  }
+}
+
+// posed models are centred on the bind pose and scaled to height
+void rig_fit(const rig_t *rig, float height, Vector3 *origin, float *k) {
+  *origin = Vector3Scale(Vector3Add(rig->bounds.min, rig->bounds.max), 0.5f);
+  *k = height / (rig->bounds.max.y - rig->bounds.min.y);
+}
+
+// poses the bone boxes at time (seconds into the animation), centred on
+// the bind pose and scaled to height
+// writes box_cnt boxes to out and their bounds
+void rig_pose(const rig_t *rig, int anim, float time, float height,
+	      obb_t out[static RIG_HITBOX_CAP], BoundingBox *bounds) {
+  const Transform *p0, *p1;
+  float u;
+  rig_frames(rig, anim, time, &p0, &p1, &u);
+
+  Vector3 origin;
+  float k;
+  rig_fit(rig, height, &origin, &k);
+  bounds->min = (Vector3) { INFINITY, INFINITY, INFINITY };
+  bounds->max = (Vector3) { -INFINITY, -INFINITY, -INFINITY };
+  for (size_t i = 0; i < rig->box_cnt; ++i) {
+    const bone_box_t *box = &rig->boxes[i];
+    Transform a = p0[box->bone], b = p1[box->bone];
+    Vector3 t = Vector3Lerp(a.translation, b.translation, u);
+    Quaternion q = QuaternionNlerp(a.rotation, b.rotation, u);
+    Vector3 s = Vector3Lerp(a.scale, b.scale, u);
+
+    obb_t *o = &out[i];
+    Vector3 c = Vector3Add(t, Vector3RotateByQuaternion(Vector3Multiply(box->center, s), q));
+    o->center = Vector3Scale(Vector3Subtract(c, origin), k);
+    o->axes[0] = Vector3RotateByQuaternion((Vector3) { 1, 0, 0 }, q);
+    o->axes[1] = Vector3RotateByQuaternion((Vector3) { 0, 1, 0 }, q);
+    o->axes[2] = Vector3RotateByQuaternion((Vector3) { 0, 0, 1 }, q);
+    o->half = Vector3Scale(Vector3Multiply(box->half, s), k);
+
+    // extent of the box along the world axes
+    Vector3 e = {
+      fabsf(o->axes[0].x) * o->half.x + fabsf(o->axes[1].x) * o->half.y + fabsf(o->axes[2].x) * o->half.z,
+      fabsf(o->axes[0].y) * o->half.x + fabsf(o->axes[1].y) * o->half.y + fabsf(o->axes[2].y) * o->half.z,
+      fabsf(o->axes[0].z) * o->half.x + fabsf(o->axes[1].z) * o->half.y + fabsf(o->axes[2].z) * o->half.z,
+    };
+    bounds->min = Vector3Min(bounds->min, Vector3Subtract(o->center, e));
+    bounds->max = Vector3Max(bounds->max, Vector3Add(o->center, e));
+  }
+}
+
+// floats rig_skin writes
+size_t rig_skin_len(const rig_t *rig) {
+  size_t n = 0;
+  for (int i = 0; i < rig->model.meshCount; ++i) n += 3 * rig->model.meshes[i].vertexCount;
+  return n;
+}
+
+// skins every mesh of the rig at time with the bone transforms rig_pose
+// poses the boxes from, so the model lines up with its hitboxes
+// the vertex positions of one mesh after the other go to out, centred
+// and scaled like the boxes
+// NOTE: positions only, the default shader doesn't light anything
+void rig_skin(const rig_t *rig, int anim, float time, float height, float *out) {
+  const Model *m = &rig->model;
+  assert(m->boneCount <= RIG_BONE_CAP && "RIG HAS TOO MANY BONES");
+  const Transform *p0, *p1;
+  float u;
+  rig_frames(rig, anim, time, &p0, &p1, &u);
+  Vector3 origin;
+  float k;
+  rig_fit(rig, height, &origin, &k);
+
+  // once per bone rather than per vertex
+  Quaternion bind[RIG_BONE_CAP];
+  Quaternion rotation[RIG_BONE_CAP];
+  Vector3 translation[RIG_BONE_CAP];
+  Vector3 scale[RIG_BONE_CAP];
+  for (int b = 0; b < m->boneCount; ++b) {
+    bind[b] = QuaternionInvert(m->bindPose[b].rotation);
+    rotation[b] = QuaternionNlerp(p0[b].rotation, p1[b].rotation, u);
+    translation[b] = Vector3Lerp(p0[b].translation, p1[b].translation, u);
+    scale[b] = Vector3Lerp(p0[b].scale, p1[b].scale, u);
+  }
+
+  for (int i = 0; i < m->meshCount; ++i) {
+    const Mesh *mesh = &m->meshes[i];
+    for (int v = 0; v < mesh->vertexCount; ++v) {
+      Vector3 p = { mesh->vertices[3*v], mesh->vertices[3*v + 1], mesh->vertices[3*v + 2] };
+      // to the bind space of each bone like rig_build_boxes, then posed
+      // like the boxes in rig_pose
+      if (mesh->boneIds && mesh->boneWeights) {
+	Vector3 skinned = Vector3Zero();
+	for (int j = 0; j < 4; ++j) {
+	  float w = mesh->boneWeights[4*v + j];
+	  int b = mesh->boneIds[4*v + j];
+	  if (w == 0 || b >= m->boneCount) continue;
+	  Vector3 local = Vector3RotateByQuaternion(Vector3Subtract(p, m->bindPose[b].translation), bind[b]);
+	  Vector3 posed = Vector3RotateByQuaternion(Vector3Multiply(local, scale[b]), rotation[b]);
+	  skinned = Vector3Add(skinned, Vector3Scale(Vector3Add(posed, translation[b]), w));
+	}
+	p = skinned;
+      }
+      p = Vector3Scale(Vector3Subtract(p, origin), k);
+      out[0] = p.x;
+      out[1] = p.y;
+      out[2] = p.z;
+      out += 3;
+    }
+  }
+}
@@ -1,20 +1,76 @@
+// shapes are centred on the position of their target
 typedef struct {
-  Vector3 position;
   Vector3 dims;
-  BoundingBox bbox;
 } cube_t;
 
+typedef struct {
+  float radius;
+} sphere_t;
+
+// upright, the cap spheres are centred half_height above and below
+typedef struct {
+  float radius;
+  float half_height;
+} capsule_t;
+
 typedef enum {
   TT_CUBE,
+  TT_SPHERE,
+  TT_CAPSULE,
+  // made of hitbox_t parts, e.g. head and body
+  TT_COMPOUND,
+  // skinned model with a box per bone, see rig.c
+  TT_ANIMATED,
   TT_COUNT,
 } target_type;
 
+// one part of a compound target
+typedef struct {
+  // never TT_COMPOUND
+  target_type shape;
+  Vector3 offset;
+  // scales the damage of shots landing on this part
+  float multiplier;
+  union {
+    cube_t cube;
+    sphere_t sphere;
+    capsule_t capsule;
+  };
+} hitbox_t;
+
+#define COMPOUND_PART_CAP 8
+
+typedef struct {
+  hitbox_t parts[COMPOUND_PART_CAP];
+  size_t len;
+} compound_t;
+
+typedef struct {
+  size_t rig;
+  int anim;
+  float height;
+  // scales the damage of shots landing on a head bone
+  float head_multiplier;
+  float anim_time;
+  // posed bone boxes relative to the target position, every step
+  obb_t boxes[RIG_HITBOX_CAP];
+  BoundingBox bounds;
+} animated_t;
+
 typedef struct {
   target_type shape;
   float hp;
   float spawn_chance;
+  // units per second, direction is random in the spawn area
+  float speed;
+  Vector3 position;
+  Vector3 velocity;
   union {
     cube_t cube;
+    sphere_t sphere;
+    capsule_t capsule;
+    compound_t compound;
+    animated_t animated;
   };
 } target_t;
 
@@ -28,7 +84,15 @@ typedef struct {
   Vector3 spawn_min, spawn_max;
 } spawn_pattern_t;
 
+typedef enum {
+  SM_CLICKING,
+  // score is the fraction of time the crosshair is on a target
+  SM_TRACKING,
+  SM_COUNT,
+} scenario_mode;
+
 typedef struct {
+  scenario_mode mode;
   struct {
     float firerate;
     float damage;
@@ -47,9 +111,29 @@ struct {
   size_t cap;
 } scenarios;
 
-scenario_t _current_scenario;
-spawn_pattern_t _current_spawn_pattern;
-target_t _current_target;
+// what load_scenario read from one file, the globals are left alone so
+// it can run on a worker, merge_scenario_file adds it to them
+typedef struct {
+  struct {
+    scenario_t *data;
+    size_t len;
+    size_t cap;
+  } scenarios;
+  // animated targets' rig indexes these until merged
+  struct {
+    char **data;
+    size_t len;
+    size_t cap;
+  } rig_paths;
+} scenario_file_t;
+
+// per thread, files can be parsed on several workers at once
+_Thread_local scenario_file_t *_current_file;
+_Thread_local scenario_t _current_scenario;
+_Thread_local spawn_pattern_t _current_spawn_pattern;
+_Thread_local target_t _current_target;
+// shape of the current target or of the current part of a compound target
+_Thread_local hitbox_t _current_hitbox = { .multiplier = 1 };
 
 void set_player_firerate(sv content) {
   char *new = strndup(content.data, content.len);
@@ -75,11 +159,31 @@ void set_player_damage(sv content) {
   free(new);
 }
 
+void set_scenario_mode(sv content) {
+  if (sv_cmp(content, sv_from("clicking"))) {
+    _current_scenario.mode = SM_CLICKING;
+  } else if (sv_cmp(content, sv_from("tracking"))) {
+    _current_scenario.mode = SM_TRACKING;
+  } else {
+    assert(false && "SCENARIO MODE MUST BE clicking OR tracking");
+  }
+}
+
+// must come before the dimensions
 void set_target_type(sv content) {
-  if (strncmp(content.data, "Cube", 4) != 0) {
-    assert(false && "ONLY CUBE IS IMPLEMENTED RIGHT NOW");
+  if (sv_cmp(content, sv_from("Cube"))) {
+    _current_hitbox.shape = TT_CUBE;
+  } else if (sv_cmp(content, sv_from("Sphere"))) {
+    _current_hitbox.shape = TT_SPHERE;
+  } else if (sv_cmp(content, sv_from("Capsule"))) {
+    _current_hitbox.shape = TT_CAPSULE;
+  } else if (sv_cmp(content, sv_from("Compound"))) {
+    _current_target.shape = TT_COMPOUND;
+  } else if (sv_cmp(content, sv_from("Animated"))) {
+    _current_target.shape = TT_ANIMATED;
+  } else {
+    assert(false && "TARGET TYPE MUST BE Cube, Sphere, Capsule, Compound OR Animated");
   }
-  _current_target.shape = TT_CUBE;
 }
 
 void set_target_health(sv content) {
@@ -94,8 +198,52 @@ void set_target_health(sv content) {
   free(new);
 }
 
-// TODO: THIS ONLY WORKS FOR CUBES
+// cube: width, height, depth
+// sphere: diameter
+// capsule: diameter, height (including the caps)
 void set_target_dimensions(sv content) {
+  size_t n = 0;
+  switch (_current_hitbox.shape) {
+  case TT_CUBE:    { n = 3; break; }
+  case TT_SPHERE:  { n = 1; break; }
+  case TT_CAPSULE: { n = 2; break; }
+  default: assert(false && "UNREACHABLE");
+  }
+  char *tmp = strndup(content.data, content.len);
+  char *start = tmp;
+  float vals[3] = {};
+  for (size_t i = 0; i < n; ++i) {
+    char *end;
+    vals[i] = strtof(start, &end);
+    //check for next character is ','
+    if (i != n-1 && *end != ',') {
+      assert(false && "MUST BE COMMA SEPARATED LIST");
+    }
+    start = end+1;
+  }
+  switch (_current_hitbox.shape) {
+  case TT_CUBE: {
+    _current_hitbox.cube.dims = (Vector3) {
+      vals[0], vals[1], vals[2],
+    };
+    break;
+  }
+  case TT_SPHERE: {
+    _current_hitbox.sphere.radius = vals[0] / 2;
+    break;
+  }
+  case TT_CAPSULE: {
+    assert(vals[1] >= vals[0] && "CAPSULE MUST BE AT LEAST AS TALL AS IT IS WIDE");
+    _current_hitbox.capsule.radius = vals[0] / 2;
+    _current_hitbox.capsule.half_height = (vals[1] - vals[0]) / 2;
+    break;
+  }
+  default: assert(false && "UNREACHABLE");
+  }
+  free(tmp);  
+}
+
+void set_part_offset(sv content) {
   char *tmp = strndup(content.data, content.len);
   char *start = tmp;
   float vals[3] = {};
@@ -108,10 +256,99 @@ void set_target_dimensions(sv content) {
     }
     start = end+1;
   }
-  _current_target.cube.dims = (Vector3) {
+  _current_hitbox.offset = (Vector3) {
     vals[0], vals[1], vals[2],
   };
-  free(tmp);  
+  free(tmp);
+}
+
+void set_part_multiplier(sv content) {
+  char *new = strndup(content.data, content.len);
+  char *end_ptr;
+  float val = strtof(new, &end_ptr);
+  // check whether the whole string was converted
+  if ((end_ptr - new) < content.len) {
+    assert(false && "PART MULTIPLIER VALUE IS INVALID");
+  }
+  _current_hitbox.multiplier = val;
+  free(new);
+}
+
+// glTF or IQM file with a skeleton, for animated targets
+// registered as a rig when the file is merged
+void set_target_model(sv content) {
+  scenario_file_t *f = _current_file;
+  for (size_t i = 0; i < f->rig_paths.len; ++i) {
+    if (strlen(f->rig_paths.data[i]) == content.len &&
+	strncmp(f->rig_paths.data[i], content.data, content.len) == 0) {
+      _current_target.animated.rig = i;
+      return;
+    }
+  }
+  if (f->rig_paths.len >= f->rig_paths.cap) {
+    if (f->rig_paths.cap == 0) { f->rig_paths.cap = 1; }
+    f->rig_paths.cap *= 2;
+    f->rig_paths.data = realloc(f->rig_paths.data, f->rig_paths.cap * sizeof(*f->rig_paths.data));
+    assert(f->rig_paths.data && "REALLOC FAILED");
+  }
+  f->rig_paths.data[f->rig_paths.len] = strndup(content.data, content.len);
+  _current_target.animated.rig = f->rig_paths.len++;
+}
+
+void set_target_animation(sv content) {
+  char *new = strndup(content.data, content.len);
+  char *end_ptr;
+  int val = strtol(new, &end_ptr, 10);
+  // check whether the whole string was converted
+  if ((end_ptr - new) < content.len || val < 0) {
+    assert(false && "TARGET ANIMATION INDEX IS INVALID");
+  }
+  _current_target.animated.anim = val;
+  free(new);
+}
+
+void set_target_height(sv content) {
+  char *new = strndup(content.data, content.len);
+  char *end_ptr;
+  float val = strtof(new, &end_ptr);
+  // check whether the whole string was converted
+  if ((end_ptr - new) < content.len || val <= 0) {
+    assert(false && "TARGET HEIGHT VALUE IS INVALID");
+  }
+  _current_target.animated.height = val;
+  free(new);
+}
+
+void set_target_head_multiplier(sv content) {
+  char *new = strndup(content.data, content.len);
+  char *end_ptr;
+  float val = strtof(new, &end_ptr);
+  // check whether the whole string was converted
+  if ((end_ptr - new) < content.len) {
+    assert(false && "TARGET HEAD MULTIPLIER VALUE IS INVALID");
+  }
+  _current_target.animated.head_multiplier = val;
+  free(new);
+}
+
+void push_current_part(sv content) {
+  (void)content;
+  compound_t *c = &_current_target.compound;
+  assert(c->len < COMPOUND_PART_CAP && "TOO MANY PARTS IN COMPOUND TARGET");
+  c->parts[c->len++] = _current_hitbox;
+  _current_hitbox = (hitbox_t) { .multiplier = 1 };
+}
+
+void set_target_speed(sv content) {
+  char *new = strndup(content.data, content.len);
+  char *end_ptr;
+  float val = strtof(new, &end_ptr);
+  // check whether the whole string was converted
+  if ((end_ptr - new) < content.len || val < 0) {
+    assert(false && "TARGET SPEED VALUE IS INVALID");
+  }
+  _current_target.speed = val;
+  free(new);
 }
 
 void set_target_spawn_chance(sv content) {
@@ -162,6 +399,22 @@ void set_spawn_pattern_area(sv content) {
 
 void push_current_target(sv content) {
   (void)content;
+  if (_current_target.shape == TT_ANIMATED) {
+    assert(_current_target.animated.height > 0 && "ANIMATED TARGET NEEDS A HEIGHT");
+    if (_current_target.animated.head_multiplier == 0) {
+      _current_target.animated.head_multiplier = 1;
+    }
+  } else if (_current_target.shape != TT_COMPOUND) {
+    _current_target.shape = _current_hitbox.shape;
+    switch (_current_hitbox.shape) {
+    case TT_CUBE:    { _current_target.cube    = _current_hitbox.cube;    break; }
+    case TT_SPHERE:  { _current_target.sphere  = _current_hitbox.sphere;  break; }
+    case TT_CAPSULE: { _current_target.capsule = _current_hitbox.capsule; break; }
+    default: assert(false && "UNREACHABLE");
+    }
+  }
+  _current_hitbox = (hitbox_t) { .multiplier = 1 };
+
   spawn_pattern_t *s = &_current_spawn_pattern;
   if (s->targets.len >= s->targets.cap) {
     if (s->targets.cap == 0) { s->targets.cap = 1; }
@@ -170,6 +423,7 @@ void push_current_target(sv content) {
     assert(s->targets.data && "REALLOC FAILED");
   }
   s->targets.data[s->targets.len++] = _current_target;
+  _current_target = (target_t) {};
 }
 
 void push_current_spawn_pattern(sv content) {
@@ -184,20 +438,63 @@ void push_current_spawn_pattern(sv content) {
   }
   s->spawn_patterns.data[s->spawn_patterns.len++] =
     _current_spawn_pattern;
+  // the targets now belong to the pushed pattern
+  _current_spawn_pattern = (spawn_pattern_t) {};
 }
 
 void push_current_scenario(sv content) {
   (void)content;
-  if (scenarios.len >= scenarios.cap) {
-    if (scenarios.cap == 0) { scenarios.cap = 1; }
-    scenarios.cap *= 2;
-    scenarios.data = realloc(scenarios.data, scenarios.cap  * sizeof(*scenarios.data));
-    assert(scenarios.data && "REALLOC FAILED");
+  scenario_file_t *f = _current_file;
+  if (f->scenarios.len >= f->scenarios.cap) {
+    if (f->scenarios.cap == 0) { f->scenarios.cap = 1; }
+    f->scenarios.cap *= 2;
+    f->scenarios.data = realloc(f->scenarios.data, f->scenarios.cap * sizeof(*f->scenarios.data));
+    assert(f->scenarios.data && "REALLOC FAILED");
+  }
+  f->scenarios.data[f->scenarios.len++] = _current_scenario;
+  _current_scenario = (scenario_t) {};
+}
+
+// main thread only, registers the file's rigs and moves its scenarios
+// into the globals, f is left empty
+void merge_scenario_file(scenario_file_t *f) {
+  size_t *rig = malloc(f->rig_paths.len * sizeof(*rig));
+  assert((f->rig_paths.len == 0 || rig) && "MALLOC FAILED");
+  for (size_t i = 0; i < f->rig_paths.len; ++i) {
+    rig[i] = rig_register((sv) { .data = f->rig_paths.data[i], .len = strlen(f->rig_paths.data[i]) });
+    free(f->rig_paths.data[i]);
+  }
+  for (size_t i = 0; i < f->scenarios.len; ++i) {
+    scenario_t *scen = &f->scenarios.data[i];
+    for (size_t j = 0; j < scen->spawn_patterns.len; ++j) {
+      spawn_pattern_t *s = &scen->spawn_patterns.data[j];
+      for (size_t k = 0; k < s->targets.len; ++k) {
+	target_t *t = &s->targets.data[k];
+	if (t->shape == TT_ANIMATED) t->animated.rig = rig[t->animated.rig];
+      }
+    }
+    if (scenarios.len >= scenarios.cap) {
+      if (scenarios.cap == 0) { scenarios.cap = 1; }
+      scenarios.cap *= 2;
+      scenarios.data = realloc(scenarios.data, scenarios.cap  * sizeof(*scenarios.data));
+      assert(scenarios.data && "REALLOC FAILED");
+    }
+    scenarios.data[scenarios.len++] = *scen;
   }
-  scenarios.data[scenarios.len++] = _current_scenario;
+  free(rig);
+  free(f->rig_paths.data);
+  free(f->scenarios.data);
+  *f = (scenario_file_t) {};
 }
 
-void load_scenario(const char *scenario_path) {
+// into out, see merge_scenario_file
+void load_scenario(const char *scenario_path, scenario_file_t *out) {
+  *out = (scenario_file_t) {};
+  _current_file = out;
+  _current_scenario = (scenario_t) {};
+  _current_spawn_pattern = (spawn_pattern_t) {};
+  _current_target = (target_t) {};
+  _current_hitbox = (hitbox_t) { .multiplier = 1 };
   str xml = {};
   // read file into buffer
   {
@@ -218,13 +515,24 @@ void load_scenario(const char *scenario_path) {
   {
     assoc_add(&arr, sv_from("scenario"), push_current_scenario);
     assoc_add(&arr, sv_from("spawn_pattern"), push_current_spawn_pattern);
+    assoc_add(&arr, sv_from("spawn"), push_current_spawn_pattern);
     assoc_add(&arr, sv_from("target"), push_current_target);
+    assoc_add(&arr, sv_from("part"), push_current_part);
     
+    assoc_add(&arr, sv_from("mode"), set_scenario_mode);
     assoc_add(&arr, sv_from("firerate"), set_player_firerate);
     assoc_add(&arr, sv_from("damage"), set_player_damage);
     
     assoc_add(&arr, sv_from("type"), set_target_type);
+    assoc_add(&arr, sv_from("dimensions"), set_target_dimensions);
+    assoc_add(&arr, sv_from("offset"), set_part_offset);
+    assoc_add(&arr, sv_from("multiplier"), set_part_multiplier);
+    assoc_add(&arr, sv_from("model"), set_target_model);
+    assoc_add(&arr, sv_from("animation"), set_target_animation);
+    assoc_add(&arr, sv_from("height"), set_target_height);
+    assoc_add(&arr, sv_from("headMultiplier"), set_target_head_multiplier);
     assoc_add(&arr, sv_from("health"), set_target_health);
+    assoc_add(&arr, sv_from("speed"), set_target_speed);
     assoc_add(&arr, sv_from("spawnChance"), set_target_spawn_chance);
 
     assoc_add(&arr, sv_from("targetCount"), set_spawn_pattern_target_count);
@@ -235,6 +543,7 @@ void load_scenario(const char *scenario_path) {
   parse_xml(remaining, arr);
   free(xml.data);
   assoc_free(&arr);
+  _current_file = NULL;
 }
 
 // TODO: requires thinking about more
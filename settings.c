@@ -5,10 +5,20 @@
 // SETTINGS
 struct {
   int width, height;
-  float sensitivity;
+  // sensitivity as cm of mouse travel per full turn at dpi
+  float cm360;
+  int dpi;
+  // or straight as mouse counts per full turn
+  float counts360;
   int desired_fps;
 
   bool desire_fullscreen;
+  // run the gameplay simulation on its own thread
+  bool sim_threaded;
+  // shots that miss count as hits on a target the crosshair just swept over
+  bool flick_assist;
+  // threads posing animated targets, 0 is one per core
+  int workers;
   
   str desired_fps_str;
 } global_settings;
@@ -16,6 +26,10 @@ struct {
 typedef struct {
   //Font font; // probably a bad idea
   char *font_path;
+  // glyphs as signed distance fields, one small atlas sharp at any size
+  bool font_sdf;
+  // glyphs rasterized as they are first drawn, for any unicode text
+  bool font_dynamic;
   int font_size;
   float font_spacing;
   Color font_colour;  
@@ -28,6 +42,8 @@ theme_settings_t _current_theme_settings;
 theme_settings_t default_theme_settings(void) {
   return (theme_settings_t) {
     .font_path = NULL,
+    .font_sdf = true,
+    .font_dynamic = false,
     .font_size = 36,
     .font_spacing = 2.5f,
     .font_colour = (Color) { 0, 0, 0, 255 },
@@ -57,6 +73,16 @@ void set_font(sv content) {
   //assert(false && "TODO: fetch font from the name passed here");
 }
 
+void set_font_sdf(sv content) {
+  assert(content.len >=1 && "VALUE MUST BE PROVIDED");
+  _current_theme_settings.font_sdf = *content.data == '1';
+}
+
+void set_font_dynamic(sv content) {
+  assert(content.len >=1 && "VALUE MUST BE PROVIDED");
+  _current_theme_settings.font_dynamic = *content.data == '1';
+}
+
 void set_font_size(sv content) {
   char *new = strndup(content.data, content.len);
   char *end_ptr;
@@ -131,19 +157,73 @@ void set_desire_fullscreen(sv content) {
   global_settings.desire_fullscreen = *content.data == '1';
 }
 
-void set_sensitivity(sv content) {
+void set_sim_threaded(sv content) {
+  assert(content.len >=1 && "VALUE MUST BE PROVIDED");
+  global_settings.sim_threaded = *content.data == '1';
+}
+
+void set_flick_assist(sv content) {
+  assert(content.len >=1 && "VALUE MUST BE PROVIDED");
+  global_settings.flick_assist = *content.data == '1';
+}
+
+void set_workers(sv content) {
+  char *new = strndup(content.data, content.len);
+  char *end_ptr;
+  int val = strtol(new, &end_ptr, 10);
+  // check whether the whole string was converted
+  if ((end_ptr - new) < content.len || val < 0) {
+    assert(false && "WORKER COUNT VALUE IS INVALID");
+  }
+  global_settings.workers = val;
+  free(new);
+}
+
+void set_cm360(sv content) {
   char *new = strndup(content.data, content.len);
   char *end_ptr;
   float val = strtof(new, &end_ptr);
   // check whether the whole string was converted
-  if ((end_ptr - new) < content.len) {
-    assert(false && "DESIRED SENSITIVITY VALUE IS INVALID");
+  if ((end_ptr - new) < content.len || val <= 0) {
+    assert(false && "DESIRED CM/360 VALUE IS INVALID");
+  }
+  global_settings.cm360 = val;
+  free(new);
+}
+
+void set_dpi(sv content) {
+  char *new = strndup(content.data, content.len);
+  char *end_ptr;
+  int val = strtol(new, &end_ptr, 10);
+  // check whether the whole string was converted
+  if ((end_ptr - new) < content.len || val <= 0) {
+    assert(false && "DESIRED DPI VALUE IS INVALID");
   }
-  global_settings.sensitivity = val;
+  global_settings.dpi = val;
+  free(new);
+}
+
+void set_counts360(sv content) {
+  char *new = strndup(content.data, content.len);
+  char *end_ptr;
+  float val = strtof(new, &end_ptr);
+  // check whether the whole string was converted
+  if ((end_ptr - new) < content.len || val <= 0) {
+    assert(false && "DESIRED COUNTS/360 VALUE IS INVALID");
+  }
+  global_settings.counts360 = val;
   free(new);
 }
 
 void load_settings(void) {
+  // sensitivity missing from the file, aim_rad_per_count needs one
+  global_settings.cm360 = 30;
+  global_settings.dpi = 800;
+  global_settings.counts360 = 0;
+  // themes missing from the file or fields missing from a theme
+  menu_theme_settings = default_theme_settings();
+  scen_theme_settings = default_theme_settings();
+  _current_theme_settings = default_theme_settings();
   str xml = {};
   // read file into buffer
   {
@@ -163,10 +243,17 @@ void load_settings(void) {
   assoc_arr arr = assoc_init(10);
   {
     assoc_add(&arr, sv_from("resolution"), set_resolution);
-    assoc_add(&arr, sv_from("sensitivity"), set_sensitivity);
+    assoc_add(&arr, sv_from("cm360"), set_cm360);
+    assoc_add(&arr, sv_from("dpi"), set_dpi);
+    assoc_add(&arr, sv_from("counts360"), set_counts360);
     assoc_add(&arr, sv_from("fullscreen"), set_desire_fullscreen);
     assoc_add(&arr, sv_from("targetFPS"), set_desired_fps);
+    assoc_add(&arr, sv_from("simThread"), set_sim_threaded);
+    assoc_add(&arr, sv_from("flickAssist"), set_flick_assist);
+    assoc_add(&arr, sv_from("workers"), set_workers);
     assoc_add(&arr, sv_from("font"), set_font);
+    assoc_add(&arr, sv_from("fontSdf"), set_font_sdf);
+    assoc_add(&arr, sv_from("fontDynamic"), set_font_dynamic);
     assoc_add(&arr, sv_from("fontSize"), set_font_size);
     assoc_add(&arr, sv_from("fontSpacing"), set_font_spacing);
     assoc_add(&arr, sv_from("colour"), set_font_colour);
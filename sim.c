@@ -0,0 +1,513 @@
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+// SIMULATION
+// gameplay runs in fixed steps independent of the render rate,
+// the renderer interpolates between the last two steps
+// the simulation only reads the input queue so it can run on its own
+// thread (global_settings.sim_threaded) or without rendering at all
+
+#define SIM_HZ 1000
+#define SIM_DT (1.0 / SIM_HZ)
+
+#define TARGET_CAP 64
+// crossings of a target edge during a sample interval are found
+// to 1/2^TRACK_BISECT_STEPS of the interval
+#define TRACK_BISECT_STEPS 8
+#define PASS_EVENT_CAP 256
+
+// the crosshair swept over a target between two cursor samples
+// without being on it at either sample (overflick)
+typedef struct {
+  double time;
+  size_t target;
+} pass_event_t;
+
+typedef struct {
+  size_t target;
+  float distance;
+  // damage multiplier of the part hit
+  float multiplier;
+} shot_hit_t;
+
+typedef struct {
+  const scenario_t *scen;
+  target_t targets[TARGET_CAP];
+  // indices of the targets of each shape, so that hit tests run
+  // one shape at a time
+  size_t groups[TT_COUNT][TARGET_CAP];
+  size_t group_len[TT_COUNT];
+  // spawn pattern each target was spawned from
+  size_t patterns[TARGET_CAP];
+  // and the template in it, scenarios don't change while playing
+  const target_t *templates[TARGET_CAP];
+  // positions before the last step, for render interpolation
+  Vector3 prev_positions[TARGET_CAP];
+  size_t target_cnt;
+  // view after the last mouse event consumed from the input queue
+  aim_t aim;
+  // fire button held
+  bool firing;
+  // earliest time the next shot can happen
+  double next_shot;
+  // tracking is integrated up to this time
+  double track_time;
+  // seconds with the crosshair on a target, out of seconds tracked
+  double on_target;
+  double tracked;
+  // ring of the latest passes, pass_cnt counts all of them
+  pass_event_t passes[PASS_EVENT_CAP];
+  size_t pass_cnt;
+  // target passed over on the way to the current cursor sample or TARGET_CAP
+  size_t swept_target;
+  // time at the end of the last step
+  double time;
+  double time_remaining;
+  float score;
+  uint32_t rng;
+  bool done;
+} sim_t;
+
+// what the renderer reads, copied out of sim every frame while the
+// simulation thread waits so it is kept small
+typedef struct {
+  size_t target_cnt;
+  // shapes of the targets, they never change after spawning
+  const target_t *templates[TARGET_CAP];
+  Vector3 positions[TARGET_CAP];
+  Vector3 prev_positions[TARGET_CAP];
+  // of the animated targets, the renderer poses the models itself
+  float anim_times[TARGET_CAP];
+  aim_t aim;
+  double time;
+  double time_remaining;
+  float score;
+  bool done;
+} sim_view_t;
+
+sim_t sim;
+// guards sim and input_queue
+pthread_mutex_t sim_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_t sim_thread;
+bool sim_thread_running;
+
+// xorshift32, the simulation keeps its own state so that a run
+// only depends on its seed and inputs
+float sim_randf(uint32_t *rng) {
+  uint32_t x = *rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *rng = x;
+  return (float)(x >> 8) / (1 << 24);
+}
+
+void group_targets(sim_t *s) {
+  for (size_t k = 0; k < TT_COUNT; ++k) {
+    s->group_len[k] = 0;
+  }
+  for (size_t i = 0; i < s->target_cnt; ++i) {
+    target_type k = s->targets[i].shape;
+    s->groups[k][s->group_len[k]++] = i;
+  }
+}
+
+// picks a target from the pattern according to the spawn chances
+// and places it randomly in the spawn area
+void respawn_target(sim_t *s, size_t i) {
+  const spawn_pattern_t *p = &s->scen->spawn_patterns.data[s->patterns[i]];
+  assert(p->targets.len > 0 && "SPAWN PATTERN HAS NO TARGETS");
+
+  float r = sim_randf(&s->rng);
+  size_t k = 0;
+  for (; k < p->targets.len - 1; ++k) {
+    r -= p->targets.data[k].spawn_chance;
+    if (r < 0) break;
+  }
+  target_t *t = &s->targets[i];
+  *t = p->targets.data[k];
+  s->templates[i] = &p->targets.data[k];
+
+  Vector3 lo = p->spawn_min, hi = p->spawn_max;
+  float x = Lerp(lo.x, hi.x, sim_randf(&s->rng));
+  float y = Lerp(lo.y, hi.y, sim_randf(&s->rng));
+  float z = Lerp(lo.z, hi.z, sim_randf(&s->rng));
+  t->position = (Vector3){ x, y, z };
+
+  // random direction, only along the axes the area extends in
+  Vector3 v = {
+    (lo.x != hi.x) ? sim_randf(&s->rng) * 2 - 1 : 0,
+    (lo.y != hi.y) ? sim_randf(&s->rng) * 2 - 1 : 0,
+    (lo.z != hi.z) ? sim_randf(&s->rng) * 2 - 1 : 0,
+  };
+  t->velocity = Vector3Scale(Vector3Normalize(v), t->speed);
+
+  // bots don't all start on the same frame
+  if (t->shape == TT_ANIMATED) {
+    animated_t *a = &t->animated;
+    a->anim_time = sim_randf(&s->rng) * 10;
+    rig_pose(&rigs.data[a->rig], a->anim, a->anim_time, a->height, a->boxes, &a->bounds);
+  }
+
+  // don't interpolate across a respawn
+  s->prev_positions[i] = t->position;
+  if (s->swept_target == i) {
+    s->swept_target = TARGET_CAP;
+  }
+}
+
+// moves the targets to their positions at the end of the step
+// bouncing off the edges of their spawn area
+void move_targets(sim_t *s) {
+  for (size_t i = 0; i < s->target_cnt; ++i) {
+    target_t *t = &s->targets[i];
+    s->prev_positions[i] = t->position;
+    if (t->speed == 0) continue;
+
+    const spawn_pattern_t *p = &s->scen->spawn_patterns.data[s->patterns[i]];
+    float *pos = &t->position.x;
+    float *vel = &t->velocity.x;
+    const float *lo = &p->spawn_min.x;
+    const float *hi = &p->spawn_max.x;
+    for (size_t k = 0; k < 3; ++k) {
+      pos[k] += vel[k] * SIM_DT;
+      if ((pos[k] < lo[k] && vel[k] < 0) || (pos[k] > hi[k] && vel[k] > 0)) {
+	vel[k] = -vel[k];
+      }
+    }
+  }
+}
+
+// advances the animated targets in the group range [begin, end)
+// and poses their bone boxes, run on the workers
+void pose_targets_range(void *ctx, size_t begin, size_t end) {
+  sim_t *s = ctx;
+  const size_t *g = s->groups[TT_ANIMATED];
+  for (size_t k = begin; k < end; ++k) {
+    animated_t *a = &s->targets[g[k]].animated;
+    a->anim_time += SIM_DT;
+    rig_pose(&rigs.data[a->rig], a->anim, a->anim_time, a->height, a->boxes, &a->bounds);
+  }
+}
+
+// closest target hit, target is target_cnt on a miss
+// runs one loop per shape rather than branching per target
+shot_hit_t check_collision(Ray r, const sim_t *s) {
+  shot_hit_t best = {
+    .target = s->target_cnt,
+    .distance = INFINITY,
+    .multiplier = 1,
+  };
+  const size_t *g = s->groups[TT_CUBE];
+  for (size_t k = 0; k < s->group_len[TT_CUBE]; ++k) {
+    const target_t *t = &s->targets[g[k]];
+    float d = ray_cube(r, t->position, t->cube);
+    if (d < best.distance) best = (shot_hit_t) { g[k], d, 1 };
+  }
+  g = s->groups[TT_SPHERE];
+  for (size_t k = 0; k < s->group_len[TT_SPHERE]; ++k) {
+    const target_t *t = &s->targets[g[k]];
+    float d = ray_sphere(r, t->position, t->sphere);
+    if (d < best.distance) best = (shot_hit_t) { g[k], d, 1 };
+  }
+  g = s->groups[TT_CAPSULE];
+  for (size_t k = 0; k < s->group_len[TT_CAPSULE]; ++k) {
+    const target_t *t = &s->targets[g[k]];
+    float d = ray_capsule(r, t->position, t->capsule);
+    if (d < best.distance) best = (shot_hit_t) { g[k], d, 1 };
+  }
+  g = s->groups[TT_COMPOUND];
+  for (size_t k = 0; k < s->group_len[TT_COMPOUND]; ++k) {
+    const target_t *t = &s->targets[g[k]];
+    float m = 1;
+    float d = ray_compound(r, t->position, &t->compound, &m);
+    if (d < best.distance) best = (shot_hit_t) { g[k], d, m };
+  }
+  g = s->groups[TT_ANIMATED];
+  for (size_t k = 0; k < s->group_len[TT_ANIMATED]; ++k) {
+    const target_t *t = &s->targets[g[k]];
+    float m = 1;
+    float d = ray_animated(r, t->position, &t->animated, &m);
+    if (d < best.distance) best = (shot_hit_t) { g[k], d, m };
+  }
+  return best;
+}
+
+void sim_init(sim_t *s, const scenario_t *scen, double now, uint32_t seed) {
+  *s = (sim_t) {};
+  s->scen = scen;
+  // xorshift state must be non zero
+  s->rng = seed ? seed : 1;
+  s->time = now;
+  s->next_shot = now;
+  s->track_time = now;
+  s->swept_target = TARGET_CAP;
+  s->time_remaining = 5.0;
+  // straight ahead at the wall
+  s->aim = (aim_t) {};
+  for (size_t p = 0; p < scen->spawn_patterns.len; ++p) {
+    const spawn_pattern_t *pattern = &scen->spawn_patterns.data[p];
+    for (size_t j = 0; j < pattern->target_count; ++j) {
+      assert(s->target_cnt < TARGET_CAP && "TOO MANY TARGETS IN SCENARIO");
+      s->patterns[s->target_cnt] = p;
+      respawn_target(s, s->target_cnt++);
+    }
+  }
+  group_targets(s);
+}
+
+// resolves a shot against the current view
+void sim_fire(sim_t *s) {
+  Ray r = {
+    .position = (Vector3) { 0, 0, 0 },
+    .direction = aim_dir(s->aim),
+  };
+  shot_hit_t hit = check_collision(r, s);
+  // assist: count a shot that just flicked over a target
+  if (hit.target == s->target_cnt && global_settings.flick_assist &&
+      s->swept_target < s->target_cnt) {
+    hit.target = s->swept_target;
+  }
+  size_t i = hit.target;
+  if (i < s->target_cnt) {
+    s->targets[i].hp -= s->scen->player.damage * hit.multiplier;
+    if (s->targets[i].hp <= 0) {
+      if (s->scen->mode == SM_CLICKING) {
+	s->score += 1;
+      }
+      respawn_target(s, i);
+      // the template may have a different shape
+      group_targets(s);
+    }
+  }
+}
+
+float box_radius(Vector3 half_dims, Vector3 axis) {
+  return half_dims.x * fabsf(axis.x)
+    + half_dims.y * fabsf(axis.y)
+    + half_dims.z * fabsf(axis.z);
+}
+
+// whether the box at c with half dims h touches the wedge swept by a
+// view ray from the origin turning from d0 to d1
+// separating axis test on the plane of the sweep and its two edges,
+// it is conservative only right next to the origin
+bool sweep_hits_box(Vector3 d0, Vector3 d1, Vector3 c, Vector3 h) {
+  Vector3 n = Vector3CrossProduct(d0, d1);
+  // no sweep, the end rays cover it
+  if (Vector3LengthSqr(n) < 1e-12f) return false;
+  if (fabsf(Vector3DotProduct(n, c)) > box_radius(h, n)) return false;
+  Vector3 m0 = Vector3CrossProduct(n, d0);
+  if (Vector3DotProduct(m0, c) < -box_radius(h, m0)) return false;
+  Vector3 m1 = Vector3CrossProduct(d1, n);
+  if (Vector3DotProduct(m1, c) < -box_radius(h, m1)) return false;
+  return true;
+}
+
+// records the targets the crosshair passed over while turning from the
+// from view to the to view at time t, fraction u of the step
+void sim_sweep(sim_t *s, aim_t from, aim_t to, double t, float u) {
+  s->swept_target = TARGET_CAP;
+  Ray r0 = { .position = (Vector3) { 0, 0, 0 }, .direction = aim_dir(from) };
+  Ray r1 = { .position = (Vector3) { 0, 0, 0 }, .direction = aim_dir(to) };
+  for (size_t i = 0; i < s->target_cnt; ++i) {
+    const target_t *target = &s->targets[i];
+    Vector3 p = Vector3Lerp(s->prev_positions[i], target->position, u);
+    // the sweep is only tested against the bounds
+    BoundingBox b = target_bounds(target, p);
+    Vector3 c = Vector3Scale(Vector3Add(b.min, b.max), 0.5f);
+    Vector3 h = Vector3Scale(Vector3Subtract(b.max, b.min), 0.5f);
+    if (!sweep_hits_box(r0.direction, r1.direction, c, h)) continue;
+
+    // being on it at either end is not a pass
+    float m;
+    if (ray_target(r0, p, target, &m) < INFINITY ||
+	ray_target(r1, p, target, &m) < INFINITY) continue;
+
+    s->passes[s->pass_cnt % PASS_EVENT_CAP] = (pass_event_t) {
+      .time = t,
+      .target = i,
+    };
+    s->pass_cnt++;
+    s->swept_target = i;
+  }
+}
+
+// true if the crosshair is on any target, at fraction u of the step
+bool sim_on_target(const sim_t *s, aim_t aim, float u) {
+  Ray r = {
+    .position = (Vector3) { 0, 0, 0 },
+    .direction = aim_dir(aim),
+  };
+  for (size_t i = 0; i < s->target_cnt; ++i) {
+    const target_t *t = &s->targets[i];
+    Vector3 p = Vector3Lerp(s->prev_positions[i], t->position, u);
+    float m;
+    if (ray_target(r, p, t, &m) < INFINITY) return true;
+  }
+  return false;
+}
+
+// integrates the time on target from track_time to t, with the view
+// turning linearly from the last sample to new_aim and the targets
+// moving along the current step
+// t must not be past the end of the current step
+void sim_track(sim_t *s, double t, aim_t new_aim) {
+  double dt = t - s->track_time;
+  if (dt <= 0) return;
+
+  float u0 = (s->track_time - s->time) / SIM_DT;
+  float u1 = (t - s->time) / SIM_DT;
+  bool h0 = sim_on_target(s, s->aim, u0);
+  bool h1 = sim_on_target(s, new_aim, u1);
+  double on = 0;
+  if (h0 && h1) {
+    on = dt;
+  } else if (h0 != h1) {
+    // the crosshair crossed an edge, bisect for when
+    float lo = 0, hi = 1;
+    for (size_t k = 0; k < TRACK_BISECT_STEPS; ++k) {
+      float m = (lo + hi) / 2;
+      bool hm = sim_on_target(s, aim_lerp(s->aim, new_aim, m), Lerp(u0, u1, m));
+      if (hm == h0) lo = m;
+      else hi = m;
+    }
+    float x = (lo + hi) / 2;
+    on = (h0 ? x : 1 - x) * dt;
+  }
+  s->on_target += on;
+  s->tracked += dt;
+  s->track_time = t;
+}
+
+void sim_apply_event(sim_t *s, input_event_t e) {
+  switch (e.type) {
+  case IE_MOUSE_MOVE: {
+    aim_t aim = aim_turn(s->aim, e.delta);
+    if (s->scen->mode == SM_TRACKING) {
+      sim_track(s, e.time, aim);
+    }
+    sim_sweep(s, s->aim, aim, e.time, (e.time - s->time) / SIM_DT);
+    s->aim = aim;
+    break;
+  }
+  case IE_FIRE_DOWN: {
+    s->firing = true;
+    // tapping can't beat the firerate
+    if (s->next_shot < e.time) s->next_shot = e.time;
+    break;
+  }
+  case IE_FIRE_UP:    { s->firing = false; break; }
+  default: assert(false && "UNREACHABLE");
+  }
+}
+
+// advances by exactly one step
+// input events and shots that happen before the end of the step are
+// handled in time order, so every shot uses the view at its own time
+void sim_step(sim_t *s) {
+  double step_end = s->time + SIM_DT;
+  move_targets(s);
+  // a few bots per chunk, posing one is only a couple dozen bones
+  workers_for(pose_targets_range, s, s->group_len[TT_ANIMATED], 4);
+
+  float firerate = s->scen->player.firerate;
+  input_event_t e;
+  for (;;) {
+    bool has_event = input_peek(&e) && e.time <= step_end;
+    bool has_shot = s->firing && s->next_shot <= step_end;
+    if (has_shot && (!has_event || s->next_shot < e.time)) {
+      sim_fire(s);
+      // firerate of 0 is semi automatic, one shot per press
+      if (firerate > 0) {
+	s->next_shot += 1.0 / firerate;
+      } else {
+	s->firing = false;
+      }
+    } else if (has_event) {
+      input_pop();
+      sim_apply_event(s, e);
+    } else {
+      break;
+    }
+  }
+
+  if (s->scen->mode == SM_TRACKING) {
+    // the view holds still until the next sample
+    sim_track(s, step_end, s->aim);
+    s->score = 100 * s->on_target / s->tracked;
+  }
+
+  s->time = step_end;
+  s->time_remaining -= SIM_DT;
+  if (s->time_remaining <= 0) {
+    s->done = true;
+  }
+}
+
+// runs every step that ends before now
+void sim_advance(sim_t *s, double now) {
+  while (!s->done && s->time + SIM_DT <= now) {
+    sim_step(s);
+  }
+}
+
+void sim_view(const sim_t *s, sim_view_t *v) {
+  size_t n = s->target_cnt;
+  v->target_cnt = n;
+  memcpy(v->templates, s->templates, n * sizeof(*v->templates));
+  memcpy(v->prev_positions, s->prev_positions, n * sizeof(*v->prev_positions));
+  for (size_t i = 0; i < n; ++i) {
+    v->positions[i] = s->targets[i].position;
+    v->anim_times[i] = (s->targets[i].shape == TT_ANIMATED) ? s->targets[i].animated.anim_time : 0;
+  }
+  v->aim = s->aim;
+  v->time = s->time;
+  v->time_remaining = s->time_remaining;
+  v->score = s->score;
+  v->done = s->done;
+}
+
+// how far the render time is between the previous and the last step
+float sim_alpha(const sim_view_t *v, double now) {
+  float alpha = (now - v->time) / SIM_DT;
+  return Clamp(alpha, 0, 1);
+}
+
+void *sim_thread_main(void *arg) {
+  (void)arg;
+  // the step is far cheaper than the tick so just nap between checks
+  struct timespec nap = { .tv_sec = 0, .tv_nsec = 250000 };
+  for (;;) {
+    pthread_mutex_lock(&sim_lock);
+    bool stop = !sim_thread_running || sim.done;
+    // only simulate up to the last poll, past that the inputs
+    // are not known yet
+    if (!stop) {
+      sim_advance(&sim, input_queue.last_poll);
+    }
+    pthread_mutex_unlock(&sim_lock);
+    if (stop) break;
+    nanosleep(&nap, NULL);
+  }
+  return NULL;
+}
+
+void sim_start(const scenario_t *scen, double now) {
+  input_reset(now);
+  sim_init(&sim, scen, now, rand());
+  if (global_settings.sim_threaded) {
+    sim_thread_running = true;
+    int err = pthread_create(&sim_thread, NULL, sim_thread_main, NULL);
+    assert(err == 0 && "COULD NOT START SIMULATION THREAD");
+  }
+}
+
+void sim_stop(void) {
+  if (!global_settings.sim_threaded) return;
+  pthread_mutex_lock(&sim_lock);
+  sim_thread_running = false;
+  pthread_mutex_unlock(&sim_lock);
+  pthread_join(sim_thread, NULL);
+}
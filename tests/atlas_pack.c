@@ -0,0 +1,113 @@
+// GenImageFontAtlas: the skyline bottom-left packers (packMethod 2 with
+// a POT atlas, 3 with a tight NPOT one) against the row packer (0) and
+// stb_rect_pack (1), on ascii and CJK glyph sets
+// every glyph packed by 2 and 3 must sit inside the atlas, overlap no
+// other and have its pixels copied, then all four are timed and their
+// fill (glyph area with padding over atlas area) compared
+
+#include <string.h>
+#include "raylib.h"
+#include "bench.h"
+
+#define FONTS "../raylib-5.0/examples/text/resources/"
+#define PADDING 4
+#define PASSES 20
+
+// the time of one GenImageFontAtlas call, the fill and how many glyphs
+// didn't fit
+typedef struct {
+  double time;
+  float fill;
+  int lost;
+} pack_t;
+
+bool overlaps(Rectangle a, Rectangle b) {
+  return a.x - PADDING < b.x + b.width + PADDING && b.x - PADDING < a.x + a.width + PADDING &&
+    a.y - PADDING < b.y + b.height + PADDING && b.y - PADDING < a.y + a.height + PADDING;
+}
+
+void check_packed(const char *name, int method, const GlyphInfo *glyphs, int cnt, Image atlas, const Rectangle *recs) {
+  const unsigned char *px = atlas.data;
+  for (int i = 0; i < cnt; ++i) {
+    Rectangle r = recs[i];
+    const Image *g = &glyphs[i].image;
+    check(r.width == g->width && r.height == g->height, "%s %d: glyph %d rect is %gx%g, image is %dx%d",
+	  name, method, i, r.width, r.height, g->width, g->height);
+    check(r.x >= PADDING && r.y >= PADDING && r.x + r.width + PADDING <= atlas.width &&
+	  r.y + r.height + PADDING <= atlas.height, "%s %d: glyph %d outside the %dx%d atlas",
+	  name, method, i, atlas.width, atlas.height);
+    for (int k = 0; k < i; ++k) {
+      check(!overlaps(r, recs[k]), "%s %d: glyphs %d and %d overlap", name, method, i, k);
+    }
+    // GRAY_ALPHA, coverage in alpha
+    for (int y = 0; y < g->height; ++y) {
+      for (int x = 0; x < g->width; ++x) {
+	unsigned char a = px[2 * (((int)r.y + y) * atlas.width + (int)r.x + x) + 1];
+	check(a == ((unsigned char *)g->data)[y * g->width + x], "%s %d: glyph %d pixel %d,%d not copied",
+	      name, method, i, x, y);
+      }
+    }
+  }
+}
+
+pack_t pack(const char *name, int method, const GlyphInfo *glyphs, int cnt, int size) {
+  pack_t p = { 0 };
+  Rectangle *recs = NULL;
+  Image atlas = GenImageFontAtlas(glyphs, &recs, cnt, size, PADDING, method);
+  if (method >= 2) check_packed(name, method, glyphs, cnt, atlas, recs);
+
+  double area = 0;
+  for (int i = 0; i < cnt; ++i) {
+    const Image *g = &glyphs[i].image;
+    bool placed = recs[i].width == g->width && recs[i].y + recs[i].height + PADDING <= atlas.height &&
+      recs[i].x + recs[i].width + PADDING <= atlas.width && (recs[i].width > 0 || g->width == 0);
+    if (placed) area += (g->width + 2.0 * PADDING) * (g->height + 2.0 * PADDING);
+    else p.lost++;
+  }
+  p.fill = area / ((double)atlas.width * atlas.height);
+  printf("atlas pack %s %d: %dx%d", name, method, atlas.width, atlas.height);
+  UnloadImage(atlas);
+  RL_FREE(recs);
+
+  double t = bench_now();
+  for (int k = 0; k < PASSES; ++k) {
+    atlas = GenImageFontAtlas(glyphs, &recs, cnt, size, PADDING, method);
+    UnloadImage(atlas);
+    RL_FREE(recs);
+  }
+  p.time = (bench_now() - t) / PASSES;
+  printf(", %.2f ms, %.0f%% filled, %d glyphs lost\n", p.time * 1e3, p.fill * 100, p.lost);
+  return p;
+}
+
+void run(const char *name, const char *path, int size, int *codepoints, int cnt) {
+  int len = 0;
+  unsigned char *ttf = LoadFileData(path, &len);
+  check(ttf != NULL, "%s: could not read %s", name, path);
+  GlyphInfo *glyphs = LoadFontData(ttf, len, size, codepoints, cnt, FONT_DEFAULT);
+  check(glyphs != NULL, "%s: could not rasterize %s", name, path);
+  if (!codepoints) cnt = 95;
+
+  pack_t p[4];
+  for (int m = 0; m < 4; ++m) p[m] = pack(name, m, glyphs, cnt, size);
+  check(p[2].lost == 0 && p[3].lost == 0, "%s: the skyline packers lost glyphs", name);
+  check(p[3].fill >= p[2].fill, "%s: the NPOT atlas is emptier than the POT one", name);
+
+  UnloadFontData(glyphs, cnt);
+  UnloadFileData(ttf);
+}
+
+int main(void) {
+  SetTraceLogLevel(LOG_ERROR);
+  run("ascii 32", FONTS "anonymous_pro_bold.ttf", 32, NULL, 0);
+  run("ascii 96", FONTS "pixantiqua.ttf", 96, NULL, 0);
+
+  int cnt = 0;
+  int *cjk = malloc(4000 * sizeof(*cjk));
+  for (int c = 32; c < 127; ++c) cjk[cnt++] = c;
+  for (int c = 0x3041; c < 0x3097; ++c) cjk[cnt++] = c;
+  for (int c = 0x4e00; cnt < 4000; ++c) cjk[cnt++] = c;
+  run("cjk 24", FONTS "DotGothic16-Regular.ttf", 24, cjk, cnt);
+  free(cjk);
+  return 0;
+}
@@ -0,0 +1,95 @@
+// rlLoadRenderBatchFormat: throughput and upload size of the compact
+// vertex formats against the separate buffers
+// every format must draw exactly the same frame, compact texcoords are
+// normalized shorts which land on the same texels here
+// NOTE: needs a window, it stays hidden
+
+#include <string.h>
+#include "raylib.h"
+#include "rlgl.h"
+#include "bench.h"
+
+#define WIDTH 640
+#define HEIGHT 480
+#define FRAMES 100
+#define QUADS 40000
+#define BATCH_BUFFERS 3
+#define BATCH_ELEMENTS 8192
+
+typedef struct {
+  int format;
+  const char *name;
+  // uploaded per vertex
+  int stride;
+} format_t;
+
+format_t formats[] = {
+  { RL_BATCH_VERTEX_SEPARATE,   "separate",   24 },
+  { RL_BATCH_VERTEX_COMPACT,    "compact",    20 },
+  { RL_BATCH_VERTEX_COMPACT_2D, "compact 2d", 16 },
+};
+
+// small quads all over the target, half plain and half textured
+void draw_frame(Texture2D texture, int frame) {
+  for (int i = 0; i < QUADS / 2; ++i) {
+    int x = (i * 7 + frame) % WIDTH, y = (i * 13) % HEIGHT;
+    DrawRectangle(x, y, 4, 4, (Color) { i % 256, (i / 256) % 256, frame % 256, 255 });
+  }
+  for (int i = 0; i < QUADS / 2; ++i) {
+    int x = (i * 11 + frame) % WIDTH, y = (i * 5) % HEIGHT;
+    DrawTextureRec(texture, (Rectangle) { i % 4, i % 3, 4, 4 }, (Vector2) { x, y }, WHITE);
+  }
+}
+
+int main(void) {
+  SetTraceLogLevel(LOG_WARNING);
+  SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  InitWindow(WIDTH, HEIGHT, "batch");
+  RenderTexture2D target = LoadRenderTexture(WIDTH, HEIGHT);
+  Image checked = GenImageChecked(8, 8, 1, 1, RED, BLUE);
+  Texture2D texture = LoadTextureFromImage(checked);
+  UnloadImage(checked);
+
+  Image reference = { 0 };
+  for (size_t f = 0; f < sizeof(formats)/sizeof(*formats); ++f) {
+    rlRenderBatch batch = rlLoadRenderBatchFormat(BATCH_BUFFERS, BATCH_ELEMENTS, formats[f].format);
+    rlSetRenderBatchActive(&batch);
+    unsigned int stalls = rlGetRenderBatchStalls();
+
+    // the first frame isn't timed, the last one is the same for every format
+    double t = 0;
+    for (int frame = -1; frame < FRAMES; ++frame) {
+      if (frame == 0) t = bench_now();
+      BeginTextureMode(target);
+      ClearBackground(BLACK);
+      draw_frame(texture, frame);
+      EndTextureMode();
+    }
+    // waits for the gpu
+    Image image = LoadImageFromTexture(target.texture);
+    t = bench_now() - t;
+
+    if (f == 0) {
+      reference = image;
+    } else {
+      size_t len = GetPixelDataSize(image.width, image.height, image.format);
+      check(memcmp(image.data, reference.data, len) == 0, "%s frame differs from %s",
+	    formats[f].name, formats[0].name);
+      UnloadImage(image);
+    }
+
+    double vertices = 4.0 * QUADS * FRAMES;
+    printf("batch %s: %.2f Mvert/s, %.2f MB uploaded per frame, %.2f ms per frame, %u stalls\n",
+	   formats[f].name, vertices / t * 1e-6, 4.0 * QUADS * formats[f].stride * 1e-6,
+	   t * 1e3 / FRAMES, rlGetRenderBatchStalls() - stalls);
+    rlSetRenderBatchActive(NULL);
+    rlUnloadRenderBatch(batch);
+  }
+  printf("batch: all %zu formats drew the same frame\n", sizeof(formats)/sizeof(*formats));
+
+  UnloadImage(reference);
+  UnloadTexture(texture);
+  UnloadRenderTexture(target);
+  CloseWindow();
+  return 0;
+}
@@ -0,0 +1,42 @@
+// CHECKS AND BENCHMARKS
+// shared by the programs in tests/, each one checks its raylib change
+// against the code it replaced and then times both
+// a failed check prints where and exits with 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#define check(cond, ...) do {						\
+    if (!(cond)) {							\
+      printf("%s:%d: check failed: ", __FILE__, __LINE__);		\
+      printf(__VA_ARGS__);						\
+      printf("\n");							\
+      exit(1);								\
+    }									\
+  } while (0)
+
+// seconds, monotonic
+static inline double bench_now(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// xorshift32, so every run sees the same inputs
+static uint32_t bench_rng = 2463534242u;
+
+static inline float bench_randf(void) {
+  uint32_t x = bench_rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  bench_rng = x;
+  return (float)(x >> 8) / (1 << 24);
+}
+
+// uniform in [lo, hi)
+static inline float bench_range(float lo, float hi) {
+  return lo + (hi - lo) * bench_randf();
+}
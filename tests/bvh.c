@@ -0,0 +1,115 @@
+// GenMeshBVH: GetRayCollisionMesh with a BVH against the brute force
+// loop, on a high poly mesh under a scaled and rotated transform
+// the hits must match exactly, the BVH only changes which triangles
+// are tested
+
+#include "raylib.h"
+#include "raymath.h"
+#include "bench.h"
+
+#define RINGS 255
+#define SEGMENTS 256
+#define RAYS 1000
+// the brute force loop is slow, it is only timed on some of the rays
+#define BRUTE_TIMED_RAYS 50
+
+// bumpy sphere, indexed, RINGS * SEGMENTS vertices fit the 16 bit indices
+Mesh gen_bumpy_sphere(void) {
+  Mesh mesh = { 0 };
+  mesh.vertexCount = RINGS * SEGMENTS;
+  mesh.triangleCount = 2 * (RINGS - 1) * SEGMENTS;
+  mesh.vertices = RL_MALLOC(mesh.vertexCount * 3 * sizeof(float));
+  mesh.indices = RL_MALLOC(mesh.triangleCount * 3 * sizeof(unsigned short));
+  for (int r = 0; r < RINGS; ++r) {
+    float theta = PI * r / (RINGS - 1);
+    for (int s = 0; s < SEGMENTS; ++s) {
+      float phi = 2 * PI * s / SEGMENTS;
+      float radius = 1 + 0.05f * sinf(7 * theta) * cosf(9 * phi);
+      float *v = &mesh.vertices[3 * (r * SEGMENTS + s)];
+      v[0] = radius * sinf(theta) * cosf(phi);
+      v[1] = radius * cosf(theta);
+      v[2] = radius * sinf(theta) * sinf(phi);
+    }
+  }
+  unsigned short *i = mesh.indices;
+  for (int r = 0; r < RINGS - 1; ++r) {
+    for (int s = 0; s < SEGMENTS; ++s) {
+      unsigned short a = r * SEGMENTS + s, b = r * SEGMENTS + (s + 1) % SEGMENTS;
+      unsigned short c = a + SEGMENTS, d = b + SEGMENTS;
+      *i++ = a; *i++ = c; *i++ = b;
+      *i++ = b; *i++ = c; *i++ = d;
+    }
+  }
+  return mesh;
+}
+
+// the same triangles without indices
+Mesh unindex(Mesh in) {
+  Mesh mesh = { 0 };
+  mesh.triangleCount = in.triangleCount;
+  mesh.vertexCount = 3 * in.triangleCount;
+  mesh.vertices = RL_MALLOC(mesh.vertexCount * 3 * sizeof(float));
+  for (int k = 0; k < mesh.vertexCount; ++k) {
+    for (int c = 0; c < 3; ++c) mesh.vertices[3*k + c] = in.vertices[3*in.indices[k] + c];
+  }
+  return mesh;
+}
+
+// half the rays aim at the mesh, the rest mostly miss
+Ray random_ray(void) {
+  Vector3 from = { bench_range(-6, 6), bench_range(-6, 6), bench_range(-6, 6) };
+  float spread = (bench_randf() < 0.5f) ? 1.5f : 6;
+  Vector3 to = { bench_range(-spread, spread), bench_range(-spread, spread), bench_range(-spread, spread) };
+  return (Ray) { from, Vector3Normalize(Vector3Subtract(to, from)) };
+}
+
+bool same_hit(RayCollision a, RayCollision b) {
+  if (a.hit != b.hit) return false;
+  if (!a.hit) return true;
+  return a.distance == b.distance &&
+    Vector3Equals(a.point, b.point) && Vector3Equals(a.normal, b.normal);
+}
+
+void run(const char *name, Mesh mesh, Matrix transform) {
+  Ray rays[RAYS];
+  for (int i = 0; i < RAYS; ++i) rays[i] = random_ray();
+
+  RayCollision brute[RAYS];
+  for (int i = 0; i < RAYS; ++i) brute[i] = GetRayCollisionMesh(rays[i], mesh, transform);
+  double t = bench_now();
+  for (int i = 0; i < BRUTE_TIMED_RAYS; ++i) GetRayCollisionMesh(rays[i], mesh, transform);
+  double brute_time = (bench_now() - t) / BRUTE_TIMED_RAYS;
+
+  t = bench_now();
+  GenMeshBVH(&mesh);
+  double build_time = bench_now() - t;
+  check(mesh.bvh != NULL, "%s: no BVH built", name);
+
+  int hits = 0;
+  t = bench_now();
+  for (int i = 0; i < RAYS; ++i) {
+    RayCollision c = GetRayCollisionMesh(rays[i], mesh, transform);
+    hits += c.hit;
+    check(same_hit(c, brute[i]), "%s: ray %d hit %d at %f, brute force hit %d at %f",
+	  name, i, c.hit, c.distance, brute[i].hit, brute[i].distance);
+  }
+  double bvh_time = (bench_now() - t) / RAYS;
+
+  printf("bvh %s: %d triangles, %d/%d rays hit and match, build %.1f ms, "
+	 "brute force %.1f us/ray, bvh %.2f us/ray (%.0fx)\n",
+	 name, mesh.triangleCount, hits, RAYS, build_time * 1e3,
+	 brute_time * 1e6, bvh_time * 1e6, brute_time / bvh_time);
+  UnloadMesh(mesh);
+}
+
+int main(void) {
+  SetTraceLogLevel(LOG_WARNING);
+  Matrix transform = MatrixMultiply(MatrixMultiply(MatrixScale(1.5f, 0.7f, 1.2f),
+						   MatrixRotateXYZ((Vector3) { 0.3f, 1.1f, -0.4f })),
+				    MatrixTranslate(0.25f, -0.5f, 0.1f));
+  Mesh indexed = gen_bumpy_sphere();
+  Mesh flat = unindex(indexed);
+  run("indexed", indexed, transform);
+  run("unindexed", flat, MatrixIdentity());
+  return 0;
+}
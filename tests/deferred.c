@@ -0,0 +1,107 @@
+// rlEnableDeferredDraws: a menu-like frame of boxes, outlines, triangle
+// icons, two textures and text on three layers, drawn in submission
+// order and then deferred and sorted by layer, texture and mode
+// both must draw exactly the same frame, rlGetDrawCallCounters gives
+// the draws recorded and submitted for each
+// NOTE: needs a window, it stays hidden
+
+#include <string.h>
+#include "raylib.h"
+#include "rlgl.h"
+#include "bench.h"
+
+#define WIDTH 640
+#define HEIGHT 480
+#define FRAMES 100
+#define COLUMNS 4
+#define ROWS 6
+#define LAYER_BOX 0
+#define LAYER_ICON 1
+#define LAYER_TEXT 2
+
+// nothing on a layer overlaps anything else on it, so sorting within a
+// layer can't change the frame
+void draw_frame(Texture2D textures[2]) {
+  for (int r = 0; r < ROWS; ++r) {
+    for (int c = 0; c < COLUMNS; ++c) {
+      int i = r * COLUMNS + c;
+      int x = 10 + c * 155, y = 10 + r * 77, w = 145, h = 67;
+
+      rlSetDrawLayer(LAYER_BOX);
+      DrawRectangle(x, y, w, h, (Color) { 40 + i * 8, 40, 80, 255 });
+
+      rlSetDrawLayer(LAYER_ICON);
+      DrawLine(x, y, x + w, y, YELLOW);
+      DrawLine(x, y + h, x + w, y + h, YELLOW);
+      DrawTexture(textures[i % 2], x + 8, y + 8, WHITE);
+      rlBegin(RL_TRIANGLES);
+      rlColor4ub(0, 200, 100, 255);
+      rlVertex2f(x + 120, y + 10);
+      rlVertex2f(x + 110, y + 30);
+      rlVertex2f(x + 130, y + 30);
+      rlEnd();
+
+      // blended over the box
+      rlSetDrawLayer(LAYER_TEXT);
+      DrawText(TextFormat("button %d", i), x + 8, y + 44, 10, (Color) { 255, 255, 255, 200 });
+    }
+  }
+  rlSetDrawLayer(0);
+}
+
+// the last of FRAMES frames, draw calls per frame through recorded and
+// submitted, seconds per frame through time
+Image run(RenderTexture2D target, Texture2D textures[2], bool deferred, int *recorded, int *submitted, double *time) {
+  rlGetDrawCallCounters(NULL, NULL);
+  double t = bench_now();
+  for (int frame = 0; frame < FRAMES; ++frame) {
+    BeginTextureMode(target);
+    ClearBackground(BLACK);
+    if (deferred) rlEnableDeferredDraws();
+    draw_frame(textures);
+    if (deferred) rlDisableDeferredDraws();
+    EndTextureMode();
+  }
+  // waits for the gpu
+  Image image = LoadImageFromTexture(target.texture);
+  *time = (bench_now() - t) / FRAMES;
+  rlGetDrawCallCounters(recorded, submitted);
+  *recorded /= FRAMES;
+  *submitted /= FRAMES;
+  return image;
+}
+
+int main(void) {
+  SetTraceLogLevel(LOG_WARNING);
+  SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  InitWindow(WIDTH, HEIGHT, "deferred");
+  RenderTexture2D target = LoadRenderTexture(WIDTH, HEIGHT);
+  Image a = GenImageChecked(24, 24, 4, 4, RED, BLUE);
+  Image b = GenImageGradientLinear(24, 24, 45, ORANGE, PURPLE);
+  Texture2D textures[2] = { LoadTextureFromImage(a), LoadTextureFromImage(b) };
+  UnloadImage(a);
+  UnloadImage(b);
+
+  int in_order[2], sorted[2];
+  double in_order_time, sorted_time;
+  Image reference = run(target, textures, false, &in_order[0], &in_order[1], &in_order_time);
+  Image image = run(target, textures, true, &sorted[0], &sorted[1], &sorted_time);
+  size_t len = GetPixelDataSize(image.width, image.height, image.format);
+  check(memcmp(image.data, reference.data, len) == 0, "deferred frame differs from the one drawn in order");
+  check(in_order[0] == in_order[1], "draws were merged without deferring, %d recorded, %d submitted",
+	in_order[0], in_order[1]);
+
+  printf("deferred in order: %d draws recorded, %d submitted, %.2f ms per frame\n",
+	 in_order[0], in_order[1], in_order_time * 1e3);
+  printf("deferred sorted: %d draws recorded, %d submitted, %.2f ms per frame\n",
+	 sorted[0], sorted[1], sorted_time * 1e3);
+  printf("deferred: both drew the same frame\n");
+
+  UnloadImage(reference);
+  UnloadImage(image);
+  UnloadTexture(textures[0]);
+  UnloadTexture(textures[1]);
+  UnloadRenderTexture(target);
+  CloseWindow();
+  return 0;
+}
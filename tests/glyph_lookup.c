@@ -0,0 +1,138 @@
+// LoadFontGlyphLookup: GetGlyphIndex through the lookup table against
+// the linear search it replaced (the same font without glyphLookup)
+// every codepoint up to 0x11000 must give the same glyph index, then
+// both are timed looking up every codepoint of a long UTF-8 string
+
+#include <string.h>
+#include "raylib.h"
+#include "bench.h"
+
+#define LAST_CODEPOINT 0x11000
+// the text benchmark, CJK with some ascii, latin-1 and emoji mixed in
+#define TEXT_CODEPOINTS 1000000
+// the linear search is slow on big fonts, it is only timed on the start
+#define LINEAR_TIMED_CODEPOINTS 20000
+
+// only glyphs[i].value is read by either lookup
+Font make_font(const int *codepoints, int count) {
+  Font font = { 0 };
+  font.glyphCount = count;
+  font.glyphs = RL_CALLOC(count, sizeof(GlyphInfo));
+  for (int i = 0; i < count; ++i) font.glyphs[i].value = codepoints[i];
+  return font;
+}
+
+void shuffle(int *v, int n) {
+  for (int i = n - 1; i > 0; --i) {
+    int k = (int)(bench_randf() * (i + 1));
+    int t = v[i];
+    v[i] = v[k];
+    v[k] = t;
+  }
+}
+
+int append_range(int *v, int n, int first, int last) {
+  for (int c = first; c <= last; ++c) v[n++] = c;
+  return n;
+}
+
+void check_all(const char *name, Font font) {
+  Font linear = font;
+  linear.glyphLookup = NULL;
+  font.glyphLookup = LoadFontGlyphLookup(font.glyphs, font.glyphCount);
+  check(font.glyphLookup != NULL, "%s: no lookup table built", name);
+  for (int c = 0; c <= LAST_CODEPOINT; ++c) {
+    int a = GetGlyphIndex(font, c), b = GetGlyphIndex(linear, c);
+    check(a == b, "%s: codepoint 0x%x gives glyph %d, linear search gives %d", name, c, a, b);
+  }
+  printf("glyph lookup %s: %d glyphs, codepoints 0 to 0x%x match\n", name, font.glyphCount, LAST_CODEPOINT);
+  RL_FREE(font.glyphLookup);
+}
+
+// seconds per codepoint decoding count codepoints of text
+double time_text(Font font, const char *text, int count, long *sum) {
+  double t = bench_now();
+  const char *c = text;
+  for (int i = 0; i < count; ++i) {
+    int bytes = 0;
+    int codepoint = GetCodepointNext(c, &bytes);
+    c += bytes;
+    *sum += GetGlyphIndex(font, codepoint);
+  }
+  return (bench_now() - t) / count;
+}
+
+void bench_text(Font font, const int *codepoints, int count) {
+  // 4 bytes at most per codepoint
+  char *text = malloc(4 * TEXT_CODEPOINTS + 1);
+  char *end = text;
+  for (int i = 0; i < TEXT_CODEPOINTS; ++i) {
+    float r = bench_randf();
+    // some codepoints aren't in the font and fall back to '?'
+    int c = (r < 0.05f) ? 0x3000 + (int)(bench_randf() * 0x10000) :
+      codepoints[(int)(bench_randf() * count)];
+    int bytes = 0;
+    const char *utf8 = CodepointToUTF8(c, &bytes);
+    memcpy(end, utf8, bytes);
+    end += bytes;
+  }
+  *end = '\0';
+
+  Font linear = font;
+  linear.glyphLookup = NULL;
+  font.glyphLookup = LoadFontGlyphLookup(font.glyphs, font.glyphCount);
+  long lookup_sum = 0, linear_sum = 0;
+  double lookup_time = time_text(font, text, TEXT_CODEPOINTS, &lookup_sum);
+  double linear_time = time_text(linear, text, LINEAR_TIMED_CODEPOINTS, &linear_sum);
+  long check_sum = 0;
+  time_text(font, text, LINEAR_TIMED_CODEPOINTS, &check_sum);
+  check(check_sum == linear_sum, "text: glyph indices differ from the linear search");
+
+  printf("glyph lookup text: %d codepoints, %.1f MB of UTF-8, linear search %.1f ns/codepoint, "
+	 "lookup %.1f ns/codepoint (%.0fx)\n",
+	 TEXT_CODEPOINTS, (end - text) / 1e6, linear_time * 1e9, lookup_time * 1e9,
+	 linear_time / lookup_time);
+  RL_FREE(font.glyphLookup);
+  free(text);
+}
+
+int main(void) {
+  SetTraceLogLevel(LOG_WARNING);
+  int *v = malloc((LAST_CODEPOINT + 1) * sizeof(*v));
+
+  // like the default font
+  int n = append_range(v, 0, 32, 126);
+  Font ascii = make_font(v, n);
+  check_all("ascii", ascii);
+
+  // like a CJK font, shuffled so nothing relies on the glyphs' order
+  n = append_range(v, 0, 32, 126);
+  n = append_range(v, n, 0xa0, 0xff);
+  n = append_range(v, n, 0x3000, 0x30ff);
+  n = append_range(v, n, 0x4e00, 0x4e00 + 6999);
+  n = append_range(v, n, 0xff00, 0xffef);
+  n = append_range(v, n, 0x1f600, 0x1f64f);
+  shuffle(v, n);
+  Font cjk = make_font(v, n);
+  check_all("cjk", cjk);
+
+  // random codepoints with repeats and no '?', the first of a repeat
+  // wins and misses fall back to glyph 0
+  int cnt = 3000;
+  int *r = malloc(cnt * sizeof(*r));
+  for (int i = 0; i < cnt; ++i) {
+    do r[i] = (int)(bench_randf() * (LAST_CODEPOINT + 1)); while (r[i] == '?');
+    if (i > 0 && bench_randf() < 0.1f) r[i] = r[(int)(bench_randf() * i)];
+  }
+  Font random = make_font(r, cnt);
+  check_all("random", random);
+
+  bench_text(cjk, v, n);
+
+  RL_FREE(ascii.glyphs);
+  RL_FREE(cjk.glyphs);
+  RL_FREE(random.glyphs);
+  free(r);
+  free(v);
+  return 0;
+}
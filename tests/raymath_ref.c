@@ -0,0 +1,8 @@
+// the scalar raymath functions under other names, raymath_simd.c builds
+// the same ones with RAYMATH_SIMD
+
+#define RAYMATH_STATIC_INLINE
+#include "raymath.h"
+
+Matrix ref_matrix_invert(Matrix m) { return MatrixInvert(m); }
+Matrix ref_matrix_transpose(Matrix m) { return MatrixTranspose(m); }
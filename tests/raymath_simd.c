@@ -0,0 +1,111 @@
+// RAYMATH_SIMD: MatrixTranspose and MatrixInvert against the scalar
+// versions (raymath_ref.c)
+// the transpose must be bit identical, the inverse only within
+// INVERT_TOLERANCE as the blockwise inverse rounds differently
+// NOTE: NEON only has a transpose, MatrixInvert is scalar there and the
+// inverse check is trivially exact
+
+#define RAYMATH_SIMD
+#define RAYMATH_STATIC_INLINE
+#include <string.h>
+#include "raymath.h"
+#include "bench.h"
+
+#define MATRIX_CNT 4096
+#define BENCH_PASSES 256
+// largest difference from the scalar inverse relative to its largest
+// element, the worst measured is ~2e-6 on transforms and ~1e-5 on
+// general matrices
+#define INVERT_TOLERANCE 1e-4f
+// general matrices with a smaller det are too badly conditioned for
+// either inverse to mean much
+#define MIN_DET 1e-2f
+
+Matrix ref_matrix_invert(Matrix m);
+Matrix ref_matrix_transpose(Matrix m);
+
+#if defined(RAYMATH_SIMD_SSE)
+  #define BACKEND "sse2"
+#elif defined(RAYMATH_SIMD_NEON)
+  #define BACKEND "neon"
+#else
+  #define BACKEND "scalar"
+#endif
+
+Matrix random_transform(void) {
+  Vector3 axis = Vector3Normalize((Vector3) { bench_range(-1, 1), bench_range(-1, 1), bench_range(-1, 1) + 0.01f });
+  Matrix s = MatrixScale(bench_range(0.1f, 10), bench_range(0.1f, 10), bench_range(0.1f, 10));
+  Matrix r = MatrixRotate(axis, bench_range(-PI, PI));
+  Matrix t = MatrixTranslate(bench_range(-100, 100), bench_range(-100, 100), bench_range(-100, 100));
+  return MatrixMultiply(MatrixMultiply(s, r), t);
+}
+
+Matrix random_matrix(void) {
+  for (;;) {
+    Matrix m;
+    float *f = &m.m0;
+    for (int i = 0; i < 16; ++i) f[i] = bench_range(-1, 1);
+    if (fabsf(MatrixDeterminant(m)) > MIN_DET) return m;
+  }
+}
+
+float max_abs(Matrix m) {
+  const float *f = &m.m0;
+  float r = 0;
+  for (int i = 0; i < 16; ++i) r = fmaxf(r, fabsf(f[i]));
+  return r;
+}
+
+// largest element difference relative to the largest element of ref
+float relative_error(Matrix m, Matrix ref) {
+  const float *a = &m.m0, *b = &ref.m0;
+  float d = 0;
+  for (int i = 0; i < 16; ++i) d = fmaxf(d, fabsf(a[i] - b[i]));
+  return d / max_abs(ref);
+}
+
+float check_inverses(const char *name, Matrix *m) {
+  float worst = 0;
+  for (int i = 0; i < MATRIX_CNT; ++i) {
+    float e = relative_error(MatrixInvert(m[i]), ref_matrix_invert(m[i]));
+    check(e <= INVERT_TOLERANCE, "%s %d: inverse off by %g relative", name, i, e);
+    if (e > worst) worst = e;
+  }
+  return worst;
+}
+
+// ns per call of fn over the matrices
+// every version is called through a pointer so none gets inlined, the
+// results are summed so the calls aren't optimized out
+float sink;
+double time_ns(Matrix (*fn)(Matrix), const Matrix *m) {
+  double t = bench_now();
+  for (int pass = 0; pass < BENCH_PASSES; ++pass) {
+    for (int i = 0; i < MATRIX_CNT; ++i) sink += fn(m[i]).m5;
+  }
+  return (bench_now() - t) * 1e9 / ((double)BENCH_PASSES * MATRIX_CNT);
+}
+
+int main(void) {
+  static Matrix transforms[MATRIX_CNT], general[MATRIX_CNT];
+  for (int i = 0; i < MATRIX_CNT; ++i) {
+    transforms[i] = random_transform();
+    general[i] = random_matrix();
+  }
+
+  for (int i = 0; i < MATRIX_CNT; ++i) {
+    Matrix a = MatrixTranspose(general[i]), b = ref_matrix_transpose(general[i]);
+    check(memcmp(&a, &b, sizeof(a)) == 0, "transpose %d differs", i);
+  }
+  float worst_transform = check_inverses("transform", transforms);
+  float worst_general = check_inverses("general", general);
+
+  printf("raymath %s: transpose bit identical, inverse worst relative error "
+	 "%.2g on transforms and %.2g on general matrices (tolerance %.0g)\n",
+	 BACKEND, worst_transform, worst_general, INVERT_TOLERANCE);
+  printf("raymath %s: MatrixInvert %.1f ns, scalar %.1f ns | "
+	 "MatrixTranspose %.1f ns, scalar %.1f ns\n", BACKEND,
+	 time_ns(MatrixInvert, general), time_ns(ref_matrix_invert, general),
+	 time_ns(MatrixTranspose, general), time_ns(ref_matrix_transpose, general));
+  return sink == 12345.f;
+}
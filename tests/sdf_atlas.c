@@ -0,0 +1,74 @@
+// load_font_sdf: a theme font loaded as a 64 px distance field atlas
+// against the 512 px bitmap atlas it replaces, the way fontcache.c loads
+// them (LoadFontData then GenImageFontAtlas)
+// both must rasterize every ascii glyph and the SDF atlas must be the
+// smaller, then their atlas bytes and load times are compared
+
+#include "raylib.h"
+#include "bench.h"
+
+#define FONTS "../raylib-5.0/examples/text/resources/"
+// main.c's FONT_BITMAP_SIZE and FONT_SDF_SIZE
+#define BITMAP_SIZE 512
+#define SDF_SIZE 64
+// fontcache.c's FONT_BITMAP_PAD, distance fields bring their own
+#define BITMAP_PAD 4
+#define GLYPHS 95
+#define PASSES 3
+
+typedef struct {
+  int width, height;
+  int bytes;
+  double time;
+} atlas_t;
+
+// like load_font_bitmap and load_font_sdf, without the glyph images
+// copied back out of the atlas
+atlas_t load(const char *name, const unsigned char *ttf, int len, int type) {
+  int size = (type == FONT_SDF) ? SDF_SIZE : BITMAP_SIZE;
+  int pad = (type == FONT_SDF) ? 0 : BITMAP_PAD;
+  int method = (type == FONT_SDF) ? 3 : 2;
+  atlas_t a = { 0 };
+  double t = bench_now();
+  for (int k = 0; k < PASSES; ++k) {
+    GlyphInfo *glyphs = LoadFontData(ttf, len, size, NULL, GLYPHS, type);
+    check(glyphs != NULL, "%s: could not rasterize at %d px", name, size);
+    for (int i = 0; i < GLYPHS; ++i) {
+      check(glyphs[i].value == ' ' || glyphs[i].image.data != NULL, "%s: glyph '%c' not rasterized at %d px",
+	    name, glyphs[i].value, size);
+    }
+    Rectangle *recs = NULL;
+    Image atlas = GenImageFontAtlas(glyphs, &recs, GLYPHS, size, pad, method);
+    check(atlas.data != NULL, "%s: no atlas at %d px", name, size);
+    a.width = atlas.width;
+    a.height = atlas.height;
+    a.bytes = GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+    UnloadImage(atlas);
+    RL_FREE(recs);
+    UnloadFontData(glyphs, GLYPHS);
+  }
+  a.time = (bench_now() - t) / PASSES;
+  return a;
+}
+
+void run(const char *name, const char *path) {
+  int len = 0;
+  unsigned char *ttf = LoadFileData(path, &len);
+  check(ttf != NULL, "%s: could not read %s", name, path);
+  atlas_t bitmap = load(name, ttf, len, FONT_DEFAULT);
+  atlas_t sdf = load(name, ttf, len, FONT_SDF);
+  check(sdf.bytes < bitmap.bytes, "%s: the SDF atlas takes %d bytes, the bitmap one %d", name, sdf.bytes, bitmap.bytes);
+  printf("sdf atlas %s: bitmap %d px %dx%d, %.1f MB, %.0f ms; SDF %d px %dx%d, %.2f MB, %.0f ms "
+	 "(%.0fx smaller, %.1fx the load time)\n",
+	 name, BITMAP_SIZE, bitmap.width, bitmap.height, bitmap.bytes / 1e6, bitmap.time * 1e3,
+	 SDF_SIZE, sdf.width, sdf.height, sdf.bytes / 1e6, sdf.time * 1e3,
+	 (double)bitmap.bytes / sdf.bytes, sdf.time / bitmap.time);
+  UnloadFileData(ttf);
+}
+
+int main(void) {
+  SetTraceLogLevel(LOG_ERROR);
+  run("anonymous pro", FONTS "anonymous_pro_bold.ttf");
+  run("pixantiqua", FONTS "pixantiqua.ttf");
+  return 0;
+}
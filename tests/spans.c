@@ -0,0 +1,456 @@
+// rlReserveVertices: the shapes and text ported to vertex spans against
+// the rlVertex* calls they replaced (ref_* below, raylib 5.0's code)
+// both must submit the same draws and the same vertices to the batch,
+// with and without a transform, then both are timed in Mvert/s
+// text no longer ends a draw per glyph, so only its z differs
+// NOTE: needs a window, it stays hidden
+
+#include <string.h>
+#include <math.h>
+#include "raylib.h"
+#include "rlgl.h"
+#include "bench.h"
+
+#define WIDTH 640
+#define HEIGHT 480
+#define BATCH_ELEMENTS 16384
+#define SHAPES 400
+#define STRINGS 40
+// the game never calls SetTextLineSpacing, raylib's default
+#define LINE_SPACING 15
+#define BENCH_VERTICES 40000000
+
+//----------------------------------------------------------------------------------
+// REFERENCE, raylib 5.0 with SUPPORT_QUADS_DRAW_MODE
+//----------------------------------------------------------------------------------
+
+static Texture2D texShapes = { 0 };
+static Rectangle texShapesRec = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+void ref_draw_rectangle_pro(Rectangle rec, Vector2 origin, float rotation, Color color) {
+  Vector2 topLeft = { 0 }, topRight = { 0 }, bottomLeft = { 0 }, bottomRight = { 0 };
+  if (rotation == 0.0f) {
+    float x = rec.x - origin.x;
+    float y = rec.y - origin.y;
+    topLeft = (Vector2) { x, y };
+    topRight = (Vector2) { x + rec.width, y };
+    bottomLeft = (Vector2) { x, y + rec.height };
+    bottomRight = (Vector2) { x + rec.width, y + rec.height };
+  } else {
+    float sinRotation = sinf(rotation * DEG2RAD);
+    float cosRotation = cosf(rotation * DEG2RAD);
+    float x = rec.x, y = rec.y;
+    float dx = -origin.x, dy = -origin.y;
+    topLeft.x = x + dx * cosRotation - dy * sinRotation;
+    topLeft.y = y + dx * sinRotation + dy * cosRotation;
+    topRight.x = x + (dx + rec.width) * cosRotation - dy * sinRotation;
+    topRight.y = y + (dx + rec.width) * sinRotation + dy * cosRotation;
+    bottomLeft.x = x + dx * cosRotation - (dy + rec.height) * sinRotation;
+    bottomLeft.y = y + dx * sinRotation + (dy + rec.height) * cosRotation;
+    bottomRight.x = x + (dx + rec.width) * cosRotation - (dy + rec.height) * sinRotation;
+    bottomRight.y = y + (dx + rec.width) * sinRotation + (dy + rec.height) * cosRotation;
+  }
+
+  rlSetTexture(texShapes.id);
+  rlBegin(RL_QUADS);
+  rlNormal3f(0.0f, 0.0f, 1.0f);
+  rlColor4ub(color.r, color.g, color.b, color.a);
+  rlTexCoord2f(texShapesRec.x / texShapes.width, texShapesRec.y / texShapes.height);
+  rlVertex2f(topLeft.x, topLeft.y);
+  rlTexCoord2f(texShapesRec.x / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+  rlVertex2f(bottomLeft.x, bottomLeft.y);
+  rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+  rlVertex2f(bottomRight.x, bottomRight.y);
+  rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, texShapesRec.y / texShapes.height);
+  rlVertex2f(topRight.x, topRight.y);
+  rlEnd();
+  rlSetTexture(0);
+}
+
+void ref_draw_rectangle_gradient_ex(Rectangle rec, Color col1, Color col2, Color col3, Color col4) {
+  rlSetTexture(texShapes.id);
+  rlBegin(RL_QUADS);
+  rlNormal3f(0.0f, 0.0f, 1.0f);
+  rlColor4ub(col1.r, col1.g, col1.b, col1.a);
+  rlTexCoord2f(texShapesRec.x / texShapes.width, texShapesRec.y / texShapes.height);
+  rlVertex2f(rec.x, rec.y);
+  rlColor4ub(col2.r, col2.g, col2.b, col2.a);
+  rlTexCoord2f(texShapesRec.x / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+  rlVertex2f(rec.x, rec.y + rec.height);
+  rlColor4ub(col3.r, col3.g, col3.b, col3.a);
+  rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+  rlVertex2f(rec.x + rec.width, rec.y + rec.height);
+  rlColor4ub(col4.r, col4.g, col4.b, col4.a);
+  rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, texShapesRec.y / texShapes.height);
+  rlVertex2f(rec.x + rec.width, rec.y);
+  rlEnd();
+  rlSetTexture(0);
+}
+
+void ref_draw_triangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) {
+  rlSetTexture(texShapes.id);
+  rlBegin(RL_QUADS);
+  rlColor4ub(color.r, color.g, color.b, color.a);
+  rlTexCoord2f(texShapesRec.x / texShapes.width, texShapesRec.y / texShapes.height);
+  rlVertex2f(v1.x, v1.y);
+  rlTexCoord2f(texShapesRec.x / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+  rlVertex2f(v2.x, v2.y);
+  rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+  rlVertex2f(v2.x, v2.y);
+  rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, texShapesRec.y / texShapes.height);
+  rlVertex2f(v3.x, v3.y);
+  rlEnd();
+  rlSetTexture(0);
+}
+
+void ref_draw_circle_sector(Vector2 center, float radius, float startAngle, float endAngle, int segments, Color color) {
+  if (radius <= 0.0f) radius = 0.1f;
+  if (endAngle < startAngle) {
+    float tmp = startAngle;
+    startAngle = endAngle;
+    endAngle = tmp;
+  }
+  int minSegments = (int)ceilf((endAngle - startAngle) / 90);
+  if (segments < minSegments) {
+    // raylib's SMOOTH_CIRCLE_ERROR_RATE
+    float th = acosf(2 * powf(1 - 0.5f / radius, 2) - 1);
+    segments = (int)((endAngle - startAngle) * ceilf(2 * PI / th) / 360);
+    if (segments <= 0) segments = minSegments;
+  }
+  float stepLength = (endAngle - startAngle) / (float)segments;
+  float angle = startAngle;
+
+  rlSetTexture(texShapes.id);
+  rlBegin(RL_QUADS);
+  for (int i = 0; i < segments / 2; i++) {
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlTexCoord2f(texShapesRec.x / texShapes.width, texShapesRec.y / texShapes.height);
+    rlVertex2f(center.x, center.y);
+    rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, texShapesRec.y / texShapes.height);
+    rlVertex2f(center.x + cosf(DEG2RAD * (angle + stepLength * 2.0f)) * radius, center.y + sinf(DEG2RAD * (angle + stepLength * 2.0f)) * radius);
+    rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+    rlVertex2f(center.x + cosf(DEG2RAD * (angle + stepLength)) * radius, center.y + sinf(DEG2RAD * (angle + stepLength)) * radius);
+    rlTexCoord2f(texShapesRec.x / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+    rlVertex2f(center.x + cosf(DEG2RAD * angle) * radius, center.y + sinf(DEG2RAD * angle) * radius);
+    angle += (stepLength * 2.0f);
+  }
+  if ((segments % 2) == 1) {
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlTexCoord2f(texShapesRec.x / texShapes.width, texShapesRec.y / texShapes.height);
+    rlVertex2f(center.x, center.y);
+    rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+    rlVertex2f(center.x + cosf(DEG2RAD * (angle + stepLength)) * radius, center.y + sinf(DEG2RAD * (angle + stepLength)) * radius);
+    rlTexCoord2f(texShapesRec.x / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+    rlVertex2f(center.x + cosf(DEG2RAD * angle) * radius, center.y + sinf(DEG2RAD * angle) * radius);
+    rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, texShapesRec.y / texShapes.height);
+    rlVertex2f(center.x, center.y);
+  }
+  rlEnd();
+  rlSetTexture(0);
+}
+
+void ref_draw_poly(Vector2 center, int sides, float radius, float rotation, Color color) {
+  if (sides < 3) sides = 3;
+  float centralAngle = rotation * DEG2RAD;
+  float angleStep = 360.0f / (float)sides * DEG2RAD;
+
+  rlSetTexture(texShapes.id);
+  rlBegin(RL_QUADS);
+  for (int i = 0; i < sides; i++) {
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    float nextAngle = centralAngle + angleStep;
+    rlTexCoord2f(texShapesRec.x / texShapes.width, texShapesRec.y / texShapes.height);
+    rlVertex2f(center.x, center.y);
+    rlTexCoord2f(texShapesRec.x / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+    rlVertex2f(center.x + cosf(centralAngle) * radius, center.y + sinf(centralAngle) * radius);
+    rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, texShapesRec.y / texShapes.height);
+    rlVertex2f(center.x + cosf(nextAngle) * radius, center.y + sinf(nextAngle) * radius);
+    rlTexCoord2f((texShapesRec.x + texShapesRec.width) / texShapes.width, (texShapesRec.y + texShapesRec.height) / texShapes.height);
+    rlVertex2f(center.x + cosf(centralAngle) * radius, center.y + sinf(centralAngle) * radius);
+    centralAngle = nextAngle;
+  }
+  rlEnd();
+  rlSetTexture(0);
+}
+
+// a glyph per DrawTexturePro, which still goes through rlVertex*
+void ref_draw_text_codepoint(Font font, int codepoint, Vector2 position, float fontSize, Color tint) {
+  int index = GetGlyphIndex(font, codepoint);
+  float scaleFactor = fontSize / font.baseSize;
+  Rectangle dstRec = { position.x + font.glyphs[index].offsetX * scaleFactor - (float)font.glyphPadding * scaleFactor,
+		       position.y + font.glyphs[index].offsetY * scaleFactor - (float)font.glyphPadding * scaleFactor,
+		       (font.recs[index].width + 2.0f * font.glyphPadding) * scaleFactor,
+		       (font.recs[index].height + 2.0f * font.glyphPadding) * scaleFactor };
+  Rectangle srcRec = { font.recs[index].x - (float)font.glyphPadding, font.recs[index].y - (float)font.glyphPadding,
+		       font.recs[index].width + 2.0f * font.glyphPadding, font.recs[index].height + 2.0f * font.glyphPadding };
+  DrawTexturePro(font.texture, srcRec, dstRec, (Vector2) { 0, 0 }, 0.0f, tint);
+}
+
+void ref_draw_text_ex(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {
+  if (font.texture.id == 0) font = GetFontDefault();
+  int size = TextLength(text);
+  int textOffsetY = 0;
+  float textOffsetX = 0.0f;
+  float scaleFactor = fontSize / font.baseSize;
+
+  for (int i = 0; i < size;) {
+    int codepointByteCount = 0;
+    int codepoint = GetCodepointNext(&text[i], &codepointByteCount);
+    int index = GetGlyphIndex(font, codepoint);
+    if (codepoint == '\n') {
+      textOffsetY += LINE_SPACING;
+      textOffsetX = 0.0f;
+    } else {
+      if ((codepoint != ' ') && (codepoint != '\t')) {
+	ref_draw_text_codepoint(font, codepoint, (Vector2) { position.x + textOffsetX, position.y + textOffsetY }, fontSize, tint);
+      }
+      if (font.glyphs[index].advanceX == 0) textOffsetX += ((float)font.recs[index].width * scaleFactor + spacing);
+      else textOffsetX += ((float)font.glyphs[index].advanceX * scaleFactor + spacing);
+    }
+    i += codepointByteCount;
+  }
+}
+
+//----------------------------------------------------------------------------------
+// SCENES
+//----------------------------------------------------------------------------------
+
+typedef enum { SHAPE_RECTANGLE, SHAPE_GRADIENT, SHAPE_TRIANGLE, SHAPE_SECTOR, SHAPE_POLY, SHAPE_KINDS } shape_e;
+
+typedef struct {
+  shape_e kind;
+  Rectangle rec;
+  Vector2 origin;
+  // degrees, of the rectangle or the poly, the sector's start angle
+  float angle;
+  float end_angle;
+  // circle segments or poly sides, under the minimum lets the sector
+  // work them out
+  int segments;
+  Color colors[4];
+} shape_t;
+
+typedef struct {
+  char text[64];
+  Vector2 position;
+  float size;
+  float spacing;
+  Color tint;
+} string_t;
+
+shape_t shapes[SHAPES];
+string_t strings[STRINGS];
+Font font;
+
+Color random_color(void) {
+  return (Color) { bench_randf() * 256, bench_randf() * 256, bench_randf() * 256, 128 + bench_randf() * 128 };
+}
+
+void make_scenes(void) {
+  for (int i = 0; i < SHAPES; ++i) {
+    shape_t *s = &shapes[i];
+    s->kind = i % SHAPE_KINDS;
+    s->rec = (Rectangle) { bench_range(0, WIDTH), bench_range(0, HEIGHT), bench_range(1, 80), bench_range(1, 80) };
+    s->origin = (Vector2) { bench_range(0, s->rec.width), bench_range(0, s->rec.height) };
+    // a third of the rectangles aren't rotated, the fast path
+    s->angle = (i % 3 == 0) ? 0.0f : bench_range(-360, 360);
+    s->end_angle = s->angle + bench_range(-400, 400);
+    s->segments = (int)bench_range(0, 40);
+    for (int k = 0; k < 4; ++k) s->colors[k] = random_color();
+  }
+  static const char *words[] = { "Score:", "12345", "Ready?", "Play", "Settings", "sensitivity", "cm/360",
+				 "\n", "AIM", "{x}", "~!@#", "\xc3\xa9t\xc3\xa9", "\t" };
+  for (int i = 0; i < STRINGS; ++i) {
+    string_t *s = &strings[i];
+    s->text[0] = '\0';
+    int n = 2 + (int)bench_range(0, 6);
+    for (int k = 0; k < n; ++k) {
+      strcat(s->text, words[(int)bench_range(0, sizeof(words) / sizeof(*words))]);
+      strcat(s->text, " ");
+    }
+    s->position = (Vector2) { bench_range(0, WIDTH), bench_range(0, HEIGHT) };
+    s->size = (float)(10 * (1 + (int)bench_range(0, 4)));
+    s->spacing = bench_range(0, 3);
+    s->tint = random_color();
+  }
+}
+
+void draw_shapes(bool ref) {
+  for (int i = 0; i < SHAPES; ++i) {
+    shape_t *s = &shapes[i];
+    Vector2 center = { s->rec.x, s->rec.y };
+    float radius = s->rec.width;
+    switch (s->kind) {
+    case SHAPE_RECTANGLE:
+      if (ref) ref_draw_rectangle_pro(s->rec, s->origin, s->angle, s->colors[0]);
+      else DrawRectanglePro(s->rec, s->origin, s->angle, s->colors[0]);
+      break;
+    case SHAPE_GRADIENT:
+      if (ref) ref_draw_rectangle_gradient_ex(s->rec, s->colors[0], s->colors[1], s->colors[2], s->colors[3]);
+      else DrawRectangleGradientEx(s->rec, s->colors[0], s->colors[1], s->colors[2], s->colors[3]);
+      break;
+    case SHAPE_TRIANGLE: {
+      Vector2 v2 = { s->rec.x + s->origin.x, s->rec.y + s->rec.height };
+      Vector2 v3 = { s->rec.x + s->rec.width, s->rec.y + s->origin.y };
+      if (ref) ref_draw_triangle(center, v2, v3, s->colors[0]);
+      else DrawTriangle(center, v2, v3, s->colors[0]);
+      break;
+    }
+    case SHAPE_SECTOR:
+      if (ref) ref_draw_circle_sector(center, radius, s->angle, s->end_angle, s->segments, s->colors[0]);
+      else DrawCircleSector(center, radius, s->angle, s->end_angle, s->segments, s->colors[0]);
+      break;
+    default:
+      if (ref) ref_draw_poly(center, 3 + s->segments, radius, s->angle, s->colors[0]);
+      else DrawPoly(center, 3 + s->segments, radius, s->angle, s->colors[0]);
+      break;
+    }
+  }
+}
+
+void draw_text(bool ref) {
+  for (int i = 0; i < STRINGS; ++i) {
+    string_t *s = &strings[i];
+    if (ref) ref_draw_text_ex(font, s->text, s->position, s->size, s->spacing, s->tint);
+    else DrawTextEx(font, s->text, s->position, s->size, s->spacing, s->tint);
+  }
+}
+
+typedef void (*scene_fn)(bool ref);
+
+//----------------------------------------------------------------------------------
+// CHECK AND BENCHMARK
+//----------------------------------------------------------------------------------
+
+// what a scene left in the active batch
+typedef struct {
+  int draws;
+  rlDrawCall *draw;
+  int vertices;
+  float *positions;
+  float *texcoords;
+  unsigned char *colors;
+} capture_t;
+
+capture_t capture(const rlRenderBatch *batch) {
+  capture_t c = { .draws = batch->drawCounter };
+  // a draw with no vertices yet is left open for the next one
+  if (c.draws > 0 && batch->draws[c.draws - 1].vertexCount == 0) c.draws--;
+  c.draw = malloc(c.draws * sizeof(*c.draw));
+  memcpy(c.draw, batch->draws, c.draws * sizeof(*c.draw));
+  for (int i = 0; i < c.draws; ++i) c.vertices += c.draw[i].vertexCount + c.draw[i].vertexAlignment;
+
+  const rlVertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+  c.positions = malloc(c.vertices * 3 * sizeof(float));
+  c.texcoords = malloc(c.vertices * 2 * sizeof(float));
+  c.colors = malloc(c.vertices * 4);
+  memcpy(c.positions, buffer->vertices, c.vertices * 3 * sizeof(float));
+  memcpy(c.texcoords, buffer->texcoords, c.vertices * 2 * sizeof(float));
+  memcpy(c.colors, buffer->colors, c.vertices * 4);
+  return c;
+}
+
+void free_capture(capture_t c) {
+  free(c.draw);
+  free(c.positions);
+  free(c.texcoords);
+  free(c.colors);
+}
+
+// the scene's vertex count, the reference submits first
+int check_scene(const char *name, scene_fn scene, rlRenderBatch *batch, bool transform, bool depth) {
+  if (transform) {
+    rlPushMatrix();
+    rlTranslatef(13.5f, -7.25f, 0.0f);
+    rlRotatef(30.0f, 0.0f, 0.0f, 1.0f);
+    rlScalef(1.5f, 0.75f, 1.0f);
+  }
+  scene(true);
+  capture_t a = capture(batch);
+  rlDrawRenderBatchActive();
+  scene(false);
+  capture_t b = capture(batch);
+  rlDrawRenderBatchActive();
+  if (transform) rlPopMatrix();
+
+  const char *how = transform ? "transformed" : "untransformed";
+  check(a.draws == b.draws, "%s %s: %d draws, the reference made %d", name, how, b.draws, a.draws);
+  int first = 0;
+  for (int i = 0; i < a.draws; ++i) {
+    rlDrawCall *x = &a.draw[i], *y = &b.draw[i];
+    check(x->mode == y->mode && x->vertexCount == y->vertexCount && x->textureId == y->textureId,
+	  "%s %s: draw %d is mode %d, %d vertices, texture %u, the reference's mode %d, %d vertices, texture %u",
+	  name, how, i, y->mode, y->vertexCount, y->textureId, x->mode, x->vertexCount, x->textureId);
+    // alignment vertices are never written
+    for (int v = first; v < first + x->vertexCount; ++v) {
+      int coords = depth ? 3 : 2;
+      check(memcmp(&a.positions[3 * v], &b.positions[3 * v], coords * sizeof(float)) == 0,
+	    "%s %s: vertex %d at %g,%g,%g, the reference's at %g,%g,%g", name, how, v,
+	    b.positions[3 * v], b.positions[3 * v + 1], b.positions[3 * v + 2],
+	    a.positions[3 * v], a.positions[3 * v + 1], a.positions[3 * v + 2]);
+      check(memcmp(&a.texcoords[2 * v], &b.texcoords[2 * v], 2 * sizeof(float)) == 0,
+	    "%s %s: vertex %d texcoord %g,%g, the reference's %g,%g", name, how, v,
+	    b.texcoords[2 * v], b.texcoords[2 * v + 1], a.texcoords[2 * v], a.texcoords[2 * v + 1]);
+      check(memcmp(&a.colors[4 * v], &b.colors[4 * v], 4) == 0, "%s %s: vertex %d color differs", name, how, v);
+    }
+    first += x->vertexCount + x->vertexAlignment;
+  }
+  printf("spans %s %s: %d draws, %d vertices match\n", name, how, a.draws, a.vertices);
+  int vertices = a.vertices;
+  free_capture(a);
+  free_capture(b);
+  return vertices;
+}
+
+// vertices per second submitting the scene, the batch is drawn between
+// passes and outside the timing
+double throughput(scene_fn scene, bool ref, bool transform, int vertices) {
+  int per_pass = BATCH_ELEMENTS * 4 / vertices;
+  int passes = BENCH_VERTICES / (per_pass * vertices);
+  if (transform) {
+    rlPushMatrix();
+    rlTranslatef(13.5f, -7.25f, 0.0f);
+  }
+  double t = 0;
+  for (int p = 0; p < passes; ++p) {
+    double start = bench_now();
+    for (int k = 0; k < per_pass; ++k) scene(ref);
+    t += bench_now() - start;
+    rlDrawRenderBatchActive();
+  }
+  if (transform) rlPopMatrix();
+  return (double)passes * per_pass * vertices / t;
+}
+
+void run(const char *name, scene_fn scene, rlRenderBatch *batch, bool depth) {
+  int vertices = check_scene(name, scene, batch, false, depth);
+  check_scene(name, scene, batch, true, depth);
+  for (int transform = 0; transform < 2; ++transform) {
+    double a = throughput(scene, true, transform, vertices);
+    double b = throughput(scene, false, transform, vertices);
+    printf("spans %s %s: rlVertex %.1f Mvert/s, spans %.1f Mvert/s (%.2fx)\n", name,
+	   transform ? "transformed" : "untransformed", a / 1e6, b / 1e6, b / a);
+  }
+}
+
+int main(void) {
+  SetTraceLogLevel(LOG_WARNING);
+  SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  InitWindow(WIDTH, HEIGHT, "spans");
+  // the same white pixel rshapes uses by default
+  texShapes = (Texture2D) { rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+  SetShapesTexture(texShapes, texShapesRec);
+  font = GetFontDefault();
+  make_scenes();
+
+  // one buffer, so every scene starts at its first vertex
+  rlRenderBatch batch = rlLoadRenderBatch(1, BATCH_ELEMENTS);
+  rlSetRenderBatchActive(&batch);
+  run("shapes", draw_shapes, &batch, true);
+  run("text", draw_text, &batch, false);
+  rlSetRenderBatchActive(NULL);
+  rlUnloadRenderBatch(batch);
+
+  CloseWindow();
+  return 0;
+}
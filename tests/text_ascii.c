@@ -0,0 +1,174 @@
+// GetTextAsciiLength: MeasureTextEx with its ASCII fast path against the
+// codepoint by codepoint loop it replaced (ref_measure_text_ex below,
+// raylib 5.0's MeasureTextEx)
+// sizes must be bit identical on random mixed ASCII/UTF-8 text,
+// including newlines, invalid bytes and cut sequences, then both are
+// timed on short and long ASCII strings and on CJK
+
+#include <string.h>
+#include "raylib.h"
+#include "bench.h"
+
+#define FONT "../raylib-5.0/examples/text/resources/DotGothic16-Regular.ttf"
+#define FONT_SIZE 32
+#define MIXED_STRINGS 5000
+#define MIXED_MAX 600
+// the game never calls SetTextLineSpacing, raylib's default
+#define LINE_SPACING 15
+#define BENCH_BYTES (64 << 20)
+
+Vector2 ref_measure_text_ex(Font font, const char *text, float fontSize, float spacing) {
+  Vector2 textSize = { 0 };
+  if ((font.texture.id == 0) || (text == NULL)) return textSize;
+
+  int size = TextLength(text);
+  int tempByteCounter = 0;
+  int byteCounter = 0;
+  float textWidth = 0.0f;
+  float tempTextWidth = 0.0f;
+  float textHeight = (float)font.baseSize;
+  float scaleFactor = fontSize / (float)font.baseSize;
+
+  for (int i = 0; i < size;) {
+    byteCounter++;
+    int next = 0;
+    int letter = GetCodepointNext(&text[i], &next);
+    int index = GetGlyphIndex(font, letter);
+    i += next;
+    if (letter != '\n') {
+      if (font.glyphs[index].advanceX != 0) textWidth += font.glyphs[index].advanceX;
+      else textWidth += (font.recs[index].width + font.glyphs[index].offsetX);
+    } else {
+      if (tempTextWidth < textWidth) tempTextWidth = textWidth;
+      byteCounter = 0;
+      textWidth = 0;
+      textHeight += (float)LINE_SPACING;
+    }
+    if (tempByteCounter < byteCounter) tempByteCounter = byteCounter;
+  }
+  if (tempTextWidth < textWidth) tempTextWidth = textWidth;
+
+  textSize.x = tempTextWidth * scaleFactor + (float)((tempByteCounter - 1) * spacing);
+  textSize.y = textHeight * scaleFactor;
+  return textSize;
+}
+
+typedef Vector2 (*measure_fn)(Font, const char *, float, float);
+
+int randi(int n) {
+  return (int)(bench_randf() * n);
+}
+
+// pieces of ASCII, Latin-1, kana, CJK, emoji (not in the font) and bad
+// UTF-8, at every alignment against the 16 byte SIMD loads
+void random_mixed(char *s, int max) {
+  static const char *bad[] = { "\x80", "\xff", "\xe3\x81", "\xf0\x9f", "\xc3" };
+  int len = 0;
+  while (len < max - 8 && randi(20) != 0) {
+    int kind = randi(6), cp = 0;
+    if (kind == 0) {
+      for (int n = randi(40); n > 0 && len < max - 8; --n) s[len++] = (randi(16) == 0) ? '\n' : 32 + randi(95);
+      continue;
+    } else if (kind == 1) {
+      const char *b = bad[randi(5)];
+      memcpy(&s[len], b, strlen(b));
+      len += strlen(b);
+      continue;
+    }
+    if (kind == 2) cp = 0xa0 + randi(0x60);
+    else if (kind == 3) cp = 0x3041 + randi(0x56);
+    else if (kind == 4) cp = 0x4e00 + randi(1000);
+    else cp = 0x1f600 + randi(0x50);
+    int bytes = 0;
+    const char *u = CodepointToUTF8(cp, &bytes);
+    memcpy(&s[len], u, bytes);
+    len += bytes;
+  }
+  s[len] = '\0';
+}
+
+void check_mixed(const char *name, Font font) {
+  char *s = malloc(MIXED_MAX + 1);
+  for (int i = 0; i < MIXED_STRINGS; ++i) {
+    random_mixed(s, MIXED_MAX);
+    float spacing = (float)randi(5) - 1;
+    Vector2 a = MeasureTextEx(font, s, FONT_SIZE * 1.5f, spacing);
+    Vector2 b = ref_measure_text_ex(font, s, FONT_SIZE * 1.5f, spacing);
+    check(memcmp(&a, &b, sizeof(a)) == 0, "%s: string %d (%d bytes) measures %gx%g, the codepoint loop %gx%g",
+	  name, i, (int)strlen(s), a.x, a.y, b.x, b.y);
+  }
+  printf("text ascii %s: %d mixed ASCII/UTF-8 strings measure the same\n", name, MIXED_STRINGS);
+  free(s);
+}
+
+// bytes per second measuring text until BENCH_BYTES have gone by
+double throughput(measure_fn measure, Font font, const char *text) {
+  int len = strlen(text);
+  int passes = BENCH_BYTES / len;
+  volatile float sink = 0;
+  double t = bench_now();
+  for (int i = 0; i < passes; ++i) sink += measure(font, text, FONT_SIZE, 1).x;
+  (void)sink;
+  return (double)passes * len / (bench_now() - t);
+}
+
+void bench(const char *name, Font font, const char *text) {
+  // through pointers so neither is inlined
+  measure_fn fast = MeasureTextEx, ref = ref_measure_text_ex;
+  double a = throughput(ref, font, text);
+  double b = throughput(fast, font, text);
+  printf("text ascii %s (%d bytes): codepoint loop %.0f MB/s, ascii runs %.0f MB/s (%.2fx)\n",
+	 name, (int)strlen(text), a / 1e6, b / 1e6, b / a);
+}
+
+int main(void) {
+  SetTraceLogLevel(LOG_WARNING);
+  int cnt = 0;
+  int *codepoints = malloc(2000 * sizeof(*codepoints));
+  for (int c = 32; c < 127; ++c) codepoints[cnt++] = c;
+  for (int c = 0xa0; c < 0x100; ++c) codepoints[cnt++] = c;
+  for (int c = 0x3041; c < 0x3097; ++c) codepoints[cnt++] = c;
+  for (int c = 0x4e00; c < 0x4e00 + 1000; ++c) codepoints[cnt++] = c;
+
+  int len = 0;
+  unsigned char *ttf = LoadFileData(FONT, &len);
+  check(ttf != NULL, "could not read " FONT);
+  // only measured, a texture id is all it needs
+  Font font = { .baseSize = FONT_SIZE, .glyphCount = cnt, .texture.id = 1 };
+  font.glyphs = LoadFontData(ttf, len, FONT_SIZE, codepoints, cnt, FONT_DEFAULT);
+  check(font.glyphs != NULL, "could not rasterize " FONT);
+  Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, cnt, FONT_SIZE, 2, 3);
+  UnloadImage(atlas);
+
+  // with the lookup table as loaded fonts have it, and without as fonts
+  // built by hand
+  font.glyphLookup = LoadFontGlyphLookup(font.glyphs, font.glyphCount);
+  check_mixed("lookup", font);
+  Font linear = font;
+  linear.glyphLookup = NULL;
+  check_mixed("no lookup", linear);
+
+  char *long_ascii = malloc(4097), *cjk = malloc(4097);
+  for (int i = 0; i < 4096; ++i) long_ascii[i] = (i % 80 == 79) ? '\n' : 32 + randi(95);
+  long_ascii[4096] = '\0';
+  int n = 0;
+  while (n < 4096 - 3) {
+    int bytes = 0;
+    const char *u = CodepointToUTF8(0x4e00 + randi(1000), &bytes);
+    memcpy(&cjk[n], u, bytes);
+    n += bytes;
+  }
+  cjk[n] = '\0';
+  bench("short", font, "Score: 12345");
+  bench("long", font, long_ascii);
+  bench("cjk", font, cjk);
+
+  free(long_ascii);
+  free(cjk);
+  RL_FREE(font.glyphLookup);
+  UnloadFontData(font.glyphs, cnt);
+  RL_FREE(font.recs);
+  UnloadFileData(ttf);
+  free(codepoints);
+  return 0;
+}
@@ -0,0 +1,445 @@
+// UI CACHE
+// retained text and screens so the menus and the HUD cost next to
+// nothing per frame
+// text is measured and laid out into glyph quads once per (font, size,
+// spacing, string) and drawn from the cache afterwards
+// text that changes every frame (the hud timer and score) would churn
+// that cache, it is laid out from quads cached per glyph instead
+// menu screens are drawn into a render texture that is only redrawn
+// when a widget on it changes or the window is resized
+
+#define TEXT_CACHE_CAP 64
+#define GLYPH_CACHE_CAP 4
+// raylib's line spacing, the game never calls SetTextLineSpacing
+#define TEXT_LINE_SPACING 15
+#define SDF_FONT_CAP 4
+
+// fonts generated as signed distance fields (see load_font_cached) are
+// drawn through this shader, which keeps them sharp at any size
+// NOTE: glsl 330, the game only runs on desktop gl 3.3
+const char *sdf_shader_fs =
+  "#version 330\n"
+  "in vec2 fragTexCoord;\n"
+  "in vec4 fragColor;\n"
+  "uniform sampler2D texture0;\n"
+  "uniform vec4 colDiffuse;\n"
+  "out vec4 finalColor;\n"
+  "void main() {\n"
+  // distance to the outline is in alpha, 0.5 on it
+  "  float d = texture(texture0, fragTexCoord).a - 0.5;\n"
+  "  float w = length(vec2(dFdx(d), dFdy(d)));\n"
+  "  float alpha = smoothstep(-w, w, d);\n"
+  "  finalColor = vec4(fragColor.rgb, fragColor.a * alpha) * colDiffuse;\n"
+  "}\n";
+
+struct {
+  unsigned int textures[SDF_FONT_CAP];
+  size_t len;
+  Shader shader;
+} sdf_fonts;
+
+// needs a window, the shader is loaded with the first font
+void add_sdf_font(Font font) {
+  assert(sdf_fonts.len < SDF_FONT_CAP && "TOO MANY SDF FONTS");
+  if (sdf_fonts.len == 0) {
+    sdf_fonts.shader = LoadShaderFromMemory(NULL, sdf_shader_fs);
+    assert(IsShaderReady(sdf_fonts.shader) && "COULD NOT LOAD SDF TEXT SHADER");
+  }
+  sdf_fonts.textures[sdf_fonts.len++] = font.texture.id;
+}
+
+bool is_sdf_texture(unsigned int id) {
+  for (size_t i = 0; i < sdf_fonts.len; ++i) {
+    if (sdf_fonts.textures[i] == id) return true;
+  }
+  return false;
+}
+
+void unload_sdf_fonts(void) {
+  if (sdf_fonts.len > 0) UnloadShader(sdf_fonts.shader);
+  sdf_fonts.len = 0;
+}
+
+typedef struct {
+  // key
+  unsigned int font;
+  float size;
+  float spacing;
+  char *text;
+  size_t hash;
+  // as MeasureTextEx
+  Vector2 extents;
+  // 4 corners per glyph, positions relative to where the text is drawn
+  // and texcoords
+  unsigned int texture;
+  bool sdf;
+  // of the dynamic font's atlas when it was laid out (see dynfont.c)
+  size_t generation;
+  size_t glyph_cnt;
+  float *vertices;
+  float *texcoords;
+  // last lookup, the least recently used run is evicted
+  size_t used;
+} text_run_t;
+
+struct {
+  text_run_t data[TEXT_CACHE_CAP];
+  size_t len;
+  size_t tick;
+} text_cache;
+
+size_t text_hash(const char *text) {
+  // FNV-1a
+  size_t h = 14695981039346656037ull;
+  for (const char *c = text; *c; ++c) {
+    h = (h ^ (unsigned char)*c) * 1099511628211ull;
+  }
+  return h;
+}
+
+// quad of glyph index with the pen at x, y, as DrawTextCodepoint
+void glyph_quad(Font font, int index, float scale, float x, float y, float *p, float *t) {
+  Rectangle rec = font.recs[index];
+  float pad = font.glyphPadding;
+  float left = x + (font.glyphs[index].offsetX - pad) * scale;
+  float top = y + (font.glyphs[index].offsetY - pad) * scale;
+  float right = left + (rec.width + 2 * pad) * scale;
+  float bottom = top + (rec.height + 2 * pad) * scale;
+  float u0 = (rec.x - pad) / font.texture.width;
+  float v0 = (rec.y - pad) / font.texture.height;
+  float u1 = (rec.x + rec.width + pad) / font.texture.width;
+  float v1 = (rec.y + rec.height + pad) / font.texture.height;
+  // top-left, bottom-left, bottom-right and top-right like rlgl quads
+  p[0] = left;  p[1] = top;    t[0] = u0; t[1] = v0;
+  p[2] = left;  p[3] = bottom; t[2] = u0; t[3] = v1;
+  p[4] = right; p[5] = bottom; t[4] = u1; t[5] = v1;
+  p[6] = right; p[7] = top;    t[6] = u1; t[7] = v0;
+}
+
+// same layout as DrawTextEx
+void text_run_build(text_run_t *r, Font font, const char *text) {
+  r->extents = MeasureTextEx(font, text, r->size, r->spacing);
+  r->texture = font.texture.id;
+  r->sdf = is_sdf_texture(r->texture);
+
+  int len = TextLength(text);
+  r->vertices = malloc(len * 8 * sizeof(*r->vertices));
+  r->texcoords = malloc(len * 8 * sizeof(*r->texcoords));
+  assert((len == 0 || (r->vertices && r->texcoords)) && "MALLOC FAILED");
+  r->glyph_cnt = 0;
+
+  float scale = r->size / font.baseSize;
+  float x = 0, y = 0;
+  for (int i = 0; i < len;) {
+    int bytes = 0;
+    int codepoint = GetCodepointNext(&text[i], &bytes);
+    int index = GetGlyphIndex(font, codepoint);
+    i += bytes;
+    if (codepoint == '\n') {
+      y += TEXT_LINE_SPACING;
+      x = 0;
+      continue;
+    }
+    if (codepoint != ' ' && codepoint != '\t') {
+      glyph_quad(font, index, scale, x, y, &r->vertices[8 * r->glyph_cnt], &r->texcoords[8 * r->glyph_cnt]);
+      r->glyph_cnt++;
+    }
+    float advance = font.glyphs[index].advanceX;
+    x += ((advance == 0) ? font.recs[index].width : advance) * scale + r->spacing;
+  }
+}
+
+void text_run_free(text_run_t *r) {
+  free(r->text);
+  free(r->vertices);
+  free(r->texcoords);
+  *r = (text_run_t) {};
+}
+
+const text_run_t *text_run(Font font, const char *text, float size, float spacing) {
+  if (font.texture.id == 0) font = GetFontDefault();
+  if (text == NULL) text = "";
+  // the copy passed in goes stale as glyphs are added
+  dyn_font_t *dyn = find_dyn_font(font.texture.id);
+  if (dyn) {
+    dyn_font_prepare(dyn, text);
+    font = dyn->font;
+  }
+  size_t generation = dyn ? dyn->generation : 0;
+  size_t h = text_hash(text);
+  text_cache.tick++;
+  for (size_t i = 0; i < text_cache.len; ++i) {
+    text_run_t *r = &text_cache.data[i];
+    if (r->hash == h && r->font == font.texture.id && r->size == size &&
+	r->spacing == spacing && strcmp(r->text, text) == 0) {
+      r->used = text_cache.tick;
+      // the glyphs moved since
+      if (r->generation != generation) {
+	free(r->vertices);
+	free(r->texcoords);
+	r->generation = generation;
+	text_run_build(r, font, text);
+      }
+      return r;
+    }
+  }
+
+  text_run_t *r;
+  if (text_cache.len < TEXT_CACHE_CAP) {
+    r = &text_cache.data[text_cache.len++];
+  } else {
+    r = &text_cache.data[0];
+    for (size_t i = 1; i < text_cache.len; ++i) {
+      if (text_cache.data[i].used < r->used) r = &text_cache.data[i];
+    }
+    text_run_free(r);
+  }
+  *r = (text_run_t) {
+    .font = font.texture.id,
+    .size = size,
+    .spacing = spacing,
+    .text = strdup(text),
+    .hash = h,
+    .generation = generation,
+    .used = text_cache.tick,
+  };
+  text_run_build(r, font, text);
+  return r;
+}
+
+Vector2 measure_text(Font font, const char *text, float size, float spacing) {
+  return text_run(font, text, size, spacing)->extents;
+}
+
+// DrawTextEx from the cached quads
+void draw_text(Font font, const char *text, Vector2 position, float size, float spacing, Color colour) {
+  const text_run_t *r = text_run(font, text, size, spacing);
+  if (r->glyph_cnt == 0) return;
+
+  if (r->sdf) BeginShaderMode(sdf_fonts.shader);
+  rlSetTexture(r->texture);
+  rlBegin(RL_QUADS);
+  rlVertexSpan span = rlReserveVertices(4 * r->glyph_cnt);
+  if (span.count > 0) {
+    for (int i = 0; i < span.count; ++i) {
+      span.vertices[3*i]     = r->vertices[2*i] + position.x;
+      span.vertices[3*i + 1] = r->vertices[2*i + 1] + position.y;
+      span.vertices[3*i + 2] = span.depth;
+      memcpy(&span.colors[4*i], &colour, 4);
+    }
+    memcpy(span.texcoords, r->texcoords, span.count * 2 * sizeof(*span.texcoords));
+    rlCommitVertices(span);
+  }
+  rlEnd();
+  rlSetTexture(0);
+
+  // too long for the batch
+  if (span.count == 0) {
+    dyn_font_t *dyn = find_dyn_font(r->font);
+    DrawTextEx(dyn ? dyn->font : font, text, position, size, spacing, colour);
+  }
+  if (r->sdf) EndShaderMode();
+}
+
+typedef struct {
+  // key
+  unsigned int font;
+  float size;
+  float spacing;
+  size_t generation;
+  unsigned int texture;
+  bool sdf;
+  // per ascii character, built the first time it is drawn
+  bool built[128];
+  bool visible[128];
+  // as MeasureTextEx and as DrawTextEx moves the pen, scaled
+  float measure[128];
+  float advance[128];
+  // relative to the pen
+  float vertices[128][8];
+  float texcoords[128][8];
+  // last lookup, the least recently used is evicted
+  size_t used;
+} glyph_quads_t;
+
+struct {
+  glyph_quads_t data[GLYPH_CACHE_CAP];
+  size_t len;
+  size_t tick;
+} glyph_cache;
+
+// single line ascii, anything else goes through the text cache
+bool is_glyph_text(const char *text) {
+  for (const char *c = text; *c; ++c) {
+    if ((unsigned char)*c >= 128 || *c == '\n') return false;
+  }
+  return true;
+}
+
+// font is swapped for the dynamic font's current copy like in text_run
+const glyph_quads_t *glyph_quads(Font *font, const char *text, float size, float spacing) {
+  if (font->texture.id == 0) *font = GetFontDefault();
+  dyn_font_t *dyn = find_dyn_font(font->texture.id);
+  if (dyn) {
+    dyn_font_prepare(dyn, text);
+    *font = dyn->font;
+  }
+  size_t generation = dyn ? dyn->generation : 0;
+  glyph_cache.tick++;
+
+  glyph_quads_t *q = NULL;
+  for (size_t i = 0; i < glyph_cache.len && !q; ++i) {
+    glyph_quads_t *c = &glyph_cache.data[i];
+    if (c->font == font->texture.id && c->size == size && c->spacing == spacing) q = c;
+  }
+  if (!q) {
+    if (glyph_cache.len < GLYPH_CACHE_CAP) {
+      q = &glyph_cache.data[glyph_cache.len++];
+    } else {
+      q = &glyph_cache.data[0];
+      for (size_t i = 1; i < glyph_cache.len; ++i) {
+	if (glyph_cache.data[i].used < q->used) q = &glyph_cache.data[i];
+      }
+    }
+    *q = (glyph_quads_t) {
+      .font = font->texture.id,
+      .size = size,
+      .spacing = spacing,
+      .generation = generation,
+      .texture = font->texture.id,
+      .sdf = is_sdf_texture(font->texture.id),
+    };
+  } else if (q->generation != generation) {
+    // the glyphs moved since
+    memset(q->built, 0, sizeof(q->built));
+    q->generation = generation;
+  }
+  q->used = glyph_cache.tick;
+
+  float scale = size / font->baseSize;
+  for (const char *c = text; *c; ++c) {
+    int ch = *c;
+    if (q->built[ch]) continue;
+    int index = GetGlyphIndex(*font, ch);
+    GlyphInfo g = font->glyphs[index];
+    q->measure[ch] = ((g.advanceX != 0) ? g.advanceX : font->recs[index].width + g.offsetX) * scale;
+    q->advance[ch] = ((g.advanceX != 0) ? g.advanceX : font->recs[index].width) * scale;
+    q->visible[ch] = (ch != ' ' && ch != '\t');
+    if (q->visible[ch]) glyph_quad(*font, index, scale, 0, 0, q->vertices[ch], q->texcoords[ch]);
+    q->built[ch] = true;
+  }
+  return q;
+}
+
+// measure_text for text that changes every frame
+Vector2 measure_glyphs(Font font, const char *text, float size, float spacing) {
+  if (text == NULL || !is_glyph_text(text)) return measure_text(font, text, size, spacing);
+  const glyph_quads_t *q = glyph_quads(&font, text, size, spacing);
+  Vector2 extents = { 0, size };
+  for (const char *c = text; *c; ++c) extents.x += q->measure[(int)*c] + spacing;
+  if (*text) extents.x -= spacing;
+  return extents;
+}
+
+// draw_text for text that changes every frame
+void draw_glyphs(Font font, const char *text, Vector2 position, float size, float spacing, Color colour) {
+  if (text == NULL || !is_glyph_text(text)) {
+    draw_text(font, text, position, size, spacing, colour);
+    return;
+  }
+  const glyph_quads_t *q = glyph_quads(&font, text, size, spacing);
+  int cnt = 0;
+  for (const char *c = text; *c; ++c) cnt += q->visible[(int)*c];
+  if (cnt == 0) return;
+
+  if (q->sdf) BeginShaderMode(sdf_fonts.shader);
+  rlSetTexture(q->texture);
+  rlBegin(RL_QUADS);
+  rlVertexSpan span = rlReserveVertices(4 * cnt);
+  if (span.count > 0) {
+    float x = position.x;
+    int k = 0;
+    for (const char *c = text; *c; ++c) {
+      int ch = *c;
+      if (q->visible[ch]) {
+	for (int i = 0; i < 4; ++i, ++k) {
+	  span.vertices[3*k]     = q->vertices[ch][2*i] + x;
+	  span.vertices[3*k + 1] = q->vertices[ch][2*i + 1] + position.y;
+	  span.vertices[3*k + 2] = span.depth;
+	  memcpy(&span.colors[4*k], &colour, 4);
+	}
+	memcpy(&span.texcoords[2*(k - 4)], q->texcoords[ch], 8 * sizeof(*span.texcoords));
+      }
+      x += q->advance[ch] + spacing;
+    }
+    rlCommitVertices(span);
+  }
+  rlEnd();
+  rlSetTexture(0);
+
+  // too long for the batch
+  if (span.count == 0) DrawTextEx(font, text, position, size, spacing, colour);
+  if (q->sdf) EndShaderMode();
+}
+
+void unload_text_cache(void) {
+  for (size_t i = 0; i < text_cache.len; ++i) text_run_free(&text_cache.data[i]);
+  text_cache.len = 0;
+  glyph_cache.len = 0;
+}
+
+typedef struct {
+  RenderTexture2D target;
+  bool dirty;
+} ui_screen_t;
+
+// screen being drawn, widgets invalidate it when they change
+ui_screen_t *ui_current = NULL;
+// false while the current screen is drawn from its texture, widgets
+// still measure and take input but skip drawing
+bool ui_drawing = true;
+
+// redraws the screen next frame
+void ui_invalidate(void) {
+  if (ui_current) ui_current->dirty = true;
+}
+
+// call after ClearBackground, the screen is cleared to the same colour
+void ui_screen_begin(ui_screen_t *s, Color background) {
+  int w = GetScreenWidth(), h = GetScreenHeight();
+  if (s->target.texture.width != w || s->target.texture.height != h) {
+    if (IsRenderTextureReady(s->target)) UnloadRenderTexture(s->target);
+    s->target = LoadRenderTexture(w, h);
+    assert(IsRenderTextureReady(s->target) && "COULD NOT CREATE UI SCREEN TEXTURE");
+    s->dirty = true;
+  }
+  ui_current = s;
+  ui_drawing = s->dirty;
+  if (ui_drawing) {
+    // widgets changing after they are drawn invalidate it again
+    s->dirty = false;
+    BeginTextureMode(s->target);
+    ClearBackground(background);
+  }
+}
+
+void ui_screen_end(ui_screen_t *s) {
+  assert(ui_current == s && "UI SCREEN END WITHOUT BEGIN");
+  if (ui_drawing) EndTextureMode();
+  ui_current = NULL;
+  ui_drawing = true;
+
+  // the texture is opaque so it is copied rather than blended again
+  // NOTE: render textures are upside down
+  rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+  BeginBlendMode(BLEND_CUSTOM);
+  DrawTextureRec(s->target.texture,
+		 (Rectangle) { 0, 0, s->target.texture.width, -s->target.texture.height },
+		 Vector2Zero(), WHITE);
+  EndBlendMode();
+}
+
+void ui_screen_free(ui_screen_t *s) {
+  if (IsRenderTextureReady(s->target)) UnloadRenderTexture(s->target);
+  *s = (ui_screen_t) {};
+}
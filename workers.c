@@ -0,0 +1,210 @@
+#include <pthread.h>
+#include <unistd.h>
+
+// WORKERS
+// small pool of threads that split a range of work between them
+// and the thread asking for it
+// in between they run background tasks, which nobody waits on (see
+// workers_submit)
+
+#define WORKER_CAP 16
+#define WORKER_TASK_CAP 32
+// glyphs per chunk when raylib rasterizes fonts on the pool, they vary
+// a lot in cost so chunks are small
+#define WORKER_RAYLIB_CHUNK 4
+
+typedef void(*work_pf)(void *ctx, size_t begin, size_t end);
+typedef void(*task_pf)(void *ctx);
+
+// owned by whoever submits it, poll it with workers_task_done
+typedef struct {
+  task_pf fn;
+  void *ctx;
+  bool done;
+} worker_task_t;
+
+struct {
+  pthread_t threads[WORKER_CAP];
+  size_t cnt;
+  // one workers_for at a time
+  pthread_mutex_t job_lock;
+  // guards everything below
+  pthread_mutex_t lock;
+  pthread_cond_t start;
+  pthread_cond_t done;
+  // current job
+  work_pf fn;
+  void *ctx;
+  size_t n;
+  size_t chunk;
+  // next index to hand out
+  size_t next;
+  // chunks handed out and not finished yet
+  size_t in_flight;
+  // bumped for every job so sleeping workers know to wake
+  size_t generation;
+  // background tasks not started yet, ring buffer
+  worker_task_t *tasks[WORKER_TASK_CAP];
+  size_t task_head;
+  size_t task_len;
+  bool quit;
+} workers = {
+  .job_lock = PTHREAD_MUTEX_INITIALIZER,
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+  .start = PTHREAD_COND_INITIALIZER,
+  .done = PTHREAD_COND_INITIALIZER,
+};
+
+// runs chunks of the current job until there are none left
+// expects workers.lock to be held
+void workers_drain(void) {
+  while (workers.next < workers.n) {
+    work_pf fn = workers.fn;
+    void *ctx = workers.ctx;
+    size_t begin = workers.next;
+    size_t end = begin + workers.chunk;
+    if (end > workers.n) end = workers.n;
+    workers.next = end;
+    workers.in_flight++;
+    pthread_mutex_unlock(&workers.lock);
+    fn(ctx, begin, end);
+    pthread_mutex_lock(&workers.lock);
+    workers.in_flight--;
+  }
+  if (workers.in_flight == 0) {
+    pthread_cond_broadcast(&workers.done);
+  }
+}
+
+// runs the oldest task, returns false if there is none
+// expects workers.lock to be held
+bool workers_run_task_locked(void) {
+  if (workers.task_len == 0) return false;
+  worker_task_t *t = workers.tasks[workers.task_head];
+  workers.task_head = (workers.task_head + 1) % WORKER_TASK_CAP;
+  workers.task_len--;
+  pthread_mutex_unlock(&workers.lock);
+  t->fn(t->ctx);
+  pthread_mutex_lock(&workers.lock);
+  t->done = true;
+  return true;
+}
+
+void *worker_main(void *arg) {
+  (void)arg;
+  size_t seen = 0;
+  pthread_mutex_lock(&workers.lock);
+  for (;;) {
+    while (!workers.quit && workers.generation == seen && workers.task_len == 0) {
+      pthread_cond_wait(&workers.start, &workers.lock);
+    }
+    if (workers.quit) break;
+    // jobs someone is waiting on come first
+    if (workers.generation != seen) {
+      seen = workers.generation;
+      workers_drain();
+      continue;
+    }
+    workers_run_task_locked();
+  }
+  pthread_mutex_unlock(&workers.lock);
+  return NULL;
+}
+
+// n of 0 uses one worker per core besides the calling thread
+void workers_init(size_t n) {
+  if (n == 0) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    n = (cores > 1) ? cores - 1 : 0;
+  }
+  if (n > WORKER_CAP) n = WORKER_CAP;
+  for (size_t i = 0; i < n; ++i) {
+    int err = pthread_create(&workers.threads[i], NULL, worker_main, NULL);
+    assert(err == 0 && "COULD NOT START WORKER THREAD");
+    workers.cnt++;
+  }
+}
+
+void workers_free(void) {
+  pthread_mutex_lock(&workers.lock);
+  workers.quit = true;
+  pthread_cond_broadcast(&workers.start);
+  pthread_mutex_unlock(&workers.lock);
+  for (size_t i = 0; i < workers.cnt; ++i) {
+    pthread_join(workers.threads[i], NULL);
+  }
+  workers.cnt = 0;
+}
+
+// calls fn on [0, n) split into chunks of at most chunk
+// returns once every chunk has finished
+void workers_for(work_pf fn, void *ctx, size_t n, size_t chunk) {
+  assert(chunk > 0 && "CHUNK SIZE MUST BE POSITIVE");
+  // not worth waking anyone
+  if (workers.cnt == 0 || n <= chunk) {
+    if (n > 0) fn(ctx, 0, n);
+    return;
+  }
+  pthread_mutex_lock(&workers.job_lock);
+  pthread_mutex_lock(&workers.lock);
+  workers.fn = fn;
+  workers.ctx = ctx;
+  workers.n = n;
+  workers.chunk = chunk;
+  workers.next = 0;
+  workers.generation++;
+  pthread_cond_broadcast(&workers.start);
+
+  workers_drain();
+  while (workers.in_flight > 0) {
+    pthread_cond_wait(&workers.done, &workers.lock);
+  }
+  pthread_mutex_unlock(&workers.lock);
+  pthread_mutex_unlock(&workers.job_lock);
+}
+
+// queues t to run on a worker, t must stay alive until it is done
+// NOTE: with no workers nothing runs it until workers_run_task is called
+// tasks may use workers_for, the pool's other threads help with it
+void workers_submit(worker_task_t *t) {
+  pthread_mutex_lock(&workers.lock);
+  assert(workers.task_len < WORKER_TASK_CAP && "TOO MANY WORKER TASKS");
+  t->done = false;
+  workers.tasks[(workers.task_head + workers.task_len) % WORKER_TASK_CAP] = t;
+  workers.task_len++;
+  pthread_cond_signal(&workers.start);
+  pthread_mutex_unlock(&workers.lock);
+}
+
+// runs the oldest queued task on the calling thread, for when there are
+// no workers, returns false if there is none
+bool workers_run_task(void) {
+  pthread_mutex_lock(&workers.lock);
+  bool ran = workers_run_task_locked();
+  pthread_mutex_unlock(&workers.lock);
+  return ran;
+}
+
+bool workers_task_done(worker_task_t *t) {
+  pthread_mutex_lock(&workers.lock);
+  bool done = t->done;
+  pthread_mutex_unlock(&workers.lock);
+  return done;
+}
+
+typedef struct {
+  ParallelWorkCallback work;
+  void *ctx;
+} raylib_job_t;
+
+void raylib_job_run(void *ctx, size_t begin, size_t end) {
+  raylib_job_t *job = ctx;
+  job->work(job->ctx, begin, end);
+}
+
+// raylib's parallel for (see SetParallelForCallback), LoadFontData
+// rasterizes the glyphs through it
+void raylib_parallel_for(ParallelWorkCallback work, void *ctx, int n) {
+  raylib_job_t job = { work, ctx };
+  workers_for(raylib_job_run, &job, n, WORKER_RAYLIB_CHUNK);
+}
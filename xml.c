@@ -39,7 +39,9 @@ void str_append(str *s, char c) {
 }
 
 // error data set when xml parsing fails
-struct {
+// NOTE: it and the tag stack are per thread, scenarios are parsed on
+// workers (see assets.c)
+_Thread_local struct {
   bool has_error;
   size_t index;  
   // the string of the error that caused xml parsing to fail
@@ -190,7 +192,7 @@ void assoc_free(assoc_arr *arr) {
   arr->count = 0;
 }
 
-struct {
+_Thread_local struct {
   // used for checking that closing tags are correct
   sv *labels;
   size_t *indices; // index of the start of the content of the associated tag